@@ -0,0 +1,324 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+/**
+ * @file
+ * Benchmarks of CDT hot paths on synthetic and real datasets.
+ * Results are printed to stdout as CSV: one line per timed operation.
+ *
+ * Usage: CDT-benchmarks [--min-exp N] [--max-exp N] [input files...]
+ * - synthetic datasets have 10^min-exp ... 10^max-exp points (default 4..6)
+ * - input files use the format of test inputs: 'nVerts nEdges', followed by
+ *   vertices' coordinates and edges' vertex indices
+ */
+
+#include <CDT.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace CDT;
+
+namespace
+{
+
+template <typename T>
+struct Dataset
+{
+    std::string name;
+    std::vector<V2d<T> > vertices;
+    EdgeVec edges;
+};
+
+template <typename T>
+const char* typeName();
+template <>
+const char* typeName<float>()
+{
+    return "f32";
+}
+template <>
+const char* typeName<double>()
+{
+    return "f64";
+}
+
+/// Prints CSV header
+void printHeader()
+{
+    std::cout << "benchmark,coord_type,index_bits,dataset,vertices,edges,"
+                 "seconds\n";
+}
+
+/// Times operations and prints results as CSV lines
+template <typename T>
+class Reporter
+{
+public:
+    explicit Reporter(const Dataset<T>& ds)
+        : m_ds(ds)
+        , m_start(std::chrono::steady_clock::now())
+    {}
+    void restart()
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+    void report(const std::string& benchmark)
+    {
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - m_start;
+        std::cout << benchmark << ',' << typeName<T>() << ','
+                  << sizeof(IndexSizeType) * 8 << ',' << m_ds.name << ','
+                  << m_ds.vertices.size() << ',' << m_ds.edges.size() << ','
+                  << elapsed.count() << std::endl;
+        restart();
+    }
+
+private:
+    const Dataset<T>& m_ds;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/// Append closed polygon approximating circle
+template <typename T>
+void addRing(Dataset<T>& ds, const double r, const std::size_t nSegments)
+{
+    const VertInd iFirst(ds.vertices.size());
+    const double pi = 3.14159265358979323846;
+    for(std::size_t i = 0; i < nSegments; ++i)
+    {
+        const double a = 2 * pi * double(i) / double(nSegments);
+        ds.vertices.push_back(V2d<T>::make(
+            T(0.5 + r * std::cos(a)), T(0.5 + r * std::sin(a))));
+        const VertInd iNext(iFirst + (i + 1) % nSegments);
+        ds.edges.push_back(Edge(VertInd(iFirst + i), iNext));
+    }
+}
+
+/**
+ * Synthetic dataset with n points in a unit square
+ * Constraints: outer boundary and a hole, both polygons with sqrt(n) edges
+ */
+template <typename T>
+Dataset<T> makeDataset(const std::string& distribution, const std::size_t n)
+{
+    Dataset<T> ds;
+    ds.name = distribution;
+    ds.vertices.reserve(n);
+    std::mt19937 gen(9001);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    const std::size_t nRing = static_cast<std::size_t>(std::sqrt(double(n)));
+    if(distribution == "uniform")
+    {
+        while(ds.vertices.size() < n - 2 * nRing)
+        {
+            const double x = uniform(gen);
+            ds.vertices.push_back(V2d<T>::make(T(x), T(uniform(gen))));
+        }
+    }
+    else if(distribution == "clustered")
+    {
+        std::normal_distribution<double> normal(0, 0.01);
+        std::vector<V2d<double> > centers;
+        for(int i = 0; i < 32; ++i)
+        {
+            const double x = uniform(gen);
+            centers.push_back(V2d<double>::make(x, uniform(gen)));
+        }
+        while(ds.vertices.size() < n - 2 * nRing)
+        {
+            const V2d<double>& c = centers[gen() % centers.size()];
+            const double x = c.x + normal(gen);
+            ds.vertices.push_back(V2d<T>::make(T(x), T(c.y + normal(gen))));
+        }
+    }
+    else if(distribution == "gridded")
+    {
+        const std::size_t side = static_cast<std::size_t>(
+            std::sqrt(double(n - 2 * nRing)));
+        for(std::size_t i = 0; i < side; ++i)
+        {
+            for(std::size_t j = 0; j < side; ++j)
+            {
+                ds.vertices.push_back(V2d<T>::make(
+                    T(double(i) / double(side)), T(double(j) / double(side))));
+            }
+        }
+    }
+    else if(distribution == "collinear")
+    {
+        // points on a few horizontal lines
+        while(ds.vertices.size() < n - 2 * nRing)
+        {
+            const double y = double(1 + gen() % 7) / 8;
+            ds.vertices.push_back(V2d<T>::make(T(uniform(gen)), T(y)));
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Unknown distribution: " + distribution);
+    }
+    addRing(ds, 0.45, nRing);
+    addRing(ds, 0.15, nRing);
+    return ds;
+}
+
+/// Dataset read from a file in tests' input format
+template <typename T>
+Dataset<T> readDataset(const std::string& fileName)
+{
+    std::ifstream f(fileName.c_str());
+    if(!f.is_open())
+        throw std::runtime_error("Could not open file '" + fileName + '\'');
+    Dataset<T> ds;
+    ds.name = fileName;
+    std::size_t nVerts, nEdges;
+    f >> nVerts >> nEdges;
+    ds.vertices.reserve(nVerts);
+    for(std::size_t i = 0; i < nVerts; ++i)
+    {
+        T x, y;
+        f >> x >> y;
+        ds.vertices.push_back(V2d<T>::make(x, y));
+    }
+    for(std::size_t i = 0; i < nEdges; ++i)
+    {
+        VertInd v1, v2;
+        f >> v1 >> v2;
+        ds.edges.push_back(Edge(v1, v2));
+    }
+    return ds;
+}
+
+/**
+ * Time near-point locator: bulk-load, queries at random positions and
+ * inserting vertices of a triangulation using the locator
+ */
+template <typename TLocator, typename T>
+void benchmarkLocator(
+    Reporter<T>& r,
+    const Dataset<T>& ds,
+    const std::string& name,
+    const VertexInsertionOrder::Enum insertionOrder)
+{
+    {
+        TLocator locator;
+        r.restart();
+        locator.initialize(ds.vertices);
+        r.report(name + ".initialize");
+        std::mt19937 gen(9001);
+        std::uniform_real_distribution<double> uniform(0, 1);
+        volatile VertInd iNear; // prevents optimizing the queries away
+        for(std::size_t i = 0; i < ds.vertices.size(); ++i)
+        {
+            const double x = uniform(gen);
+            iNear = locator.nearPoint(
+                V2d<T>::make(T(x), T(uniform(gen))), ds.vertices);
+        }
+        r.report(name + ".nearPoint");
+        (void)iNear;
+    }
+    {
+        Triangulation<T, TLocator> cdt(insertionOrder);
+        r.restart();
+        cdt.insertVertices(ds.vertices);
+        r.report(name + ".insertVertices");
+    }
+}
+
+/// Time all benchmarked operations on a dataset
+template <typename T>
+void benchmark(Dataset<T> ds)
+{
+    Reporter<T> r(ds);
+    {
+        std::vector<V2d<T> > vv = ds.vertices;
+        EdgeVec ee = ds.edges;
+        r.restart();
+        RemoveDuplicatesAndRemapEdges(vv, ee);
+        r.report("RemoveDuplicatesAndRemapEdges");
+        ds.vertices.swap(vv);
+        ds.edges.swap(ee);
+    }
+    benchmarkLocator<LocatorKDTree<T> >(
+        r, ds, "KDTree", VertexInsertionOrder::Randomized);
+    benchmarkLocator<LocatorBucketGrid<T> >(
+        r, ds, "BucketGrid", VertexInsertionOrder::Randomized);
+    // walks from the last vertex are short only for spatially sorted input
+    benchmarkLocator<LocatorLastInserted<T> >(
+        r, ds, "LastInserted", VertexInsertionOrder::BRIO);
+    {
+        Triangulation<T> cdt;
+        r.restart();
+        cdt.insertVertices(ds.vertices);
+        r.report("insertVertices");
+        cdt.insertEdges(ds.edges);
+        r.report("insertEdges");
+        cdt.eraseOuterTrianglesAndHoles();
+        r.report("eraseOuterTrianglesAndHoles");
+    }
+    {
+        Triangulation<T> brio(VertexInsertionOrder::BRIO);
+        r.restart();
+        brio.insertVertices(ds.vertices);
+        r.report("insertVertices.BRIO");
+    }
+    {
+        Triangulation<T> cdt;
+        cdt.insertVertices(ds.vertices);
+        r.restart();
+        cdt.conformToEdges(ds.edges);
+        r.report("conformToEdges");
+    }
+}
+
+template <typename T>
+void benchmarkAll(
+    const int minExp,
+    const int maxExp,
+    const std::vector<std::string>& files)
+{
+    const char* distributions[] = {
+        "uniform", "clustered", "gridded", "collinear"};
+    for(int e = minExp; e <= maxExp; ++e)
+    {
+        const std::size_t n =
+            static_cast<std::size_t>(std::pow(10., double(e)) + 0.5);
+        for(std::size_t i = 0; i < 4; ++i)
+            benchmark(makeDataset<T>(distributions[i], n));
+    }
+    typedef std::vector<std::string>::const_iterator Cit;
+    for(Cit it = files.begin(); it != files.end(); ++it)
+        benchmark(readDataset<T>(*it));
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int minExp = 4;
+    int maxExp = 6;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--min-exp" && i + 1 < argc)
+            minExp = std::atoi(argv[++i]);
+        else if(arg == "--max-exp" && i + 1 < argc)
+            maxExp = std::atoi(argv[++i]);
+        else
+            files.push_back(arg);
+    }
+    printHeader();
+    benchmarkAll<float>(minExp, maxExp, files);
+    benchmarkAll<double>(minExp, maxExp, files);
+    return 0;
+}
@@ -14,11 +14,10 @@
 #include <CDT.h>
 #include <CDTUtils.h>
 
-#ifdef CDT_CXX11_IS_SUPPORTED
 #include <algorithm>
-#endif
 #include <cstddef>
 #include <iterator>
+#include <stdexcept>
 #include <vector>
 
 namespace CDT
@@ -29,6 +28,7 @@ namespace detail
 /**
  * Generate grid vertices given of X- and Y-ticks
  *
+ * @tparam TTriIndVec vector of triangles adjacent to a vertex
  * @tparam OutputVertIt output vertices iterator
  * @tparam OutputTriIt output triangles iterator
  * @tparam TXCoordIter iterator dereferencing to X coordinate
@@ -40,6 +40,7 @@ namespace detail
  * @param ylast end of Y-ticks range
  */
 template <
+    typename TTriIndVec,
     typename OutputVertIt,
     typename OutputTriIt,
     typename TXCoordIter,
@@ -64,7 +65,7 @@ void generateGridVertices(
         {
             *outVertsFirst++ = V2d<T>::make(*xiter, *yiter);
             const std::size_t i = iy * xres + ix;
-            TriIndVec vTris;
+            TTriIndVec vTris;
             vTris.reserve(6);
             // left-up
             if(ix > 0 && iy < yres)
@@ -88,7 +89,9 @@ void generateGridVertices(
                 vTris.push_back(static_cast<TriInd>(2 * (i - xres)));
                 vTris.push_back(static_cast<TriInd>(2 * (i - xres) + 1));
             }
-#ifdef CDT_CXX11_IS_SUPPORTED
+#if defined(CDT_USE_COMPACT_VERTEX_ADJACENCY)
+            *outTrisFirst++ = vTris.front();
+#elif defined(CDT_CXX11_IS_SUPPORTED)
             *outTrisFirst++ = std::move(vTris);
 #else
             *outTrisFirst++ = vTris;
@@ -152,6 +155,7 @@ void generateGridTriangles(
  * @tparam T type of vertex coordinates (e.g., float, double)
  * @tparam TNearPointLocator class providing locating near point for efficiently
  * inserting new points.
+ * @tparam TAllocator allocator of triangulation's containers
  * @param xmin minimum X-coordinate of grid
  * @param xmax maximum X-coordinate of grid
  * @param ymin minimum Y-coordinate of grid
@@ -160,7 +164,7 @@ void generateGridTriangles(
  * @param yres grid Y-resolution
  * @param out triangulation to initialize with grid super-geometry
  */
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 void initializeWithRegularGrid(
     const T xmin,
     const T xmax,
@@ -168,7 +172,7 @@ void initializeWithRegularGrid(
     const T ymax,
     const std::size_t xres,
     const std::size_t yres,
-    Triangulation<T, TNearPointLocator>& out)
+    Triangulation<T, TNearPointLocator, TAllocator>& out)
 {
     std::vector<T> xcoords;
     std::vector<T> ycoords;
@@ -194,6 +198,7 @@ void initializeWithRegularGrid(
  * @tparam T type of vertex coordinates (e.g., float, double)
  * @tparam TNearPointLocator class providing locating near point for efficiently
  * inserting new points.
+ * @tparam TAllocator allocator of triangulation's containers
  * @tparam TXCoordIter iterator dereferencing to X coordinate
  * @tparam TYCoordIter iterator dereferencing to Y coordinate
  * @param xfirst beginning of X-ticks range
@@ -205,6 +210,7 @@ void initializeWithRegularGrid(
 template <
     typename T,
     typename TNearPointLocator,
+    typename TAllocator,
     typename TXCoordIter,
     typename TYCoordIter>
 void initializeWithIrregularGrid(
@@ -212,14 +218,16 @@ void initializeWithIrregularGrid(
     const TXCoordIter xlast,
     const TYCoordIter yfirst,
     const TYCoordIter ylast,
-    Triangulation<T, TNearPointLocator>& out)
+    Triangulation<T, TNearPointLocator, TAllocator>& out)
 {
     const std::size_t xres = std::distance(xfirst, xlast) - 1;
     const std::size_t yres = std::distance(yfirst, ylast) - 1;
     out.triangles.reserve(xres * yres * 2);
     out.vertices.reserve((xres + 1) * (yres + 1));
     out.vertTris.reserve((xres + 1) * (yres + 1));
-    detail::generateGridVertices(
+    detail::generateGridVertices<
+        typename Triangulation<T, TNearPointLocator, TAllocator>::
+            AdjacentTriangles>(
         std::back_inserter(out.vertices),
         std::back_inserter(out.vertTris),
         xfirst,
@@ -233,6 +241,122 @@ void initializeWithIrregularGrid(
     out.initializedWithCustomSuperGeometry();
 }
 
+/**
+ * Near-point locator for triangulations initialized with a regular grid
+ *
+ * Use with triangulation initialized by CDT::initializeWithRegularGrid
+ * using the same grid parameters. Grid cell containing a point is found in
+ * O(1) by arithmetic: locator returns the vertex most recently added in the
+ * cell or the nearest grid vertex. No search structure is built, which is
+ * good for rasters with sparse extra points.
+ * @tparam T type of vertex coordinates (e.g., float, double)
+ */
+template <typename T>
+class LocatorRegularGrid
+{
+public:
+    /// Default constructor: grid must be set with another constructor
+    LocatorRegularGrid()
+        : m_xres(0)
+        , m_yres(0)
+    {}
+    /**
+     * Constructor
+     * @param xmin minimum X-coordinate of grid
+     * @param xmax maximum X-coordinate of grid
+     * @param ymin minimum Y-coordinate of grid
+     * @param ymax maximum Y-coordinate of grid
+     * @param xres grid X-resolution
+     * @param yres grid Y-resolution
+     */
+    LocatorRegularGrid(
+        const T xmin,
+        const T xmax,
+        const T ymin,
+        const T ymax,
+        const std::size_t xres,
+        const std::size_t yres)
+        : m_min(V2d<T>::make(xmin, ymin))
+        , m_xCellsPerUnit(T(xres) / (xmax - xmin))
+        , m_yCellsPerUnit(T(yres) / (ymax - ymin))
+        , m_xres(xres)
+        , m_yres(yres)
+    {}
+    /**
+     * Initialize with grid vertices followed by other points
+     * @note Empty points are valid, e.g., for a triangulation that was
+     * reset: grid cells are cleared
+     */
+    template <typename TPoints>
+    void initialize(const TPoints& points)
+    {
+        if(points.empty())
+        {
+            m_cellVertices.clear();
+            return;
+        }
+        const std::size_t nGridVerts = (m_xres + 1) * (m_yres + 1);
+        if(m_xres == 0 || m_yres == 0 || points.size() < nGridVerts)
+        {
+            throw std::runtime_error(
+                "Regular grid locator requires triangulation initialized "
+                "with the same regular grid");
+        }
+        m_cellVertices.assign(m_xres * m_yres, noVertex);
+        for(std::size_t i = nGridVerts; i < points.size(); ++i)
+            addPoint(VertInd(i), points);
+    }
+    /// Add point to its grid cell
+    template <typename TPoints>
+    void addPoint(const VertInd i, const TPoints& points)
+    {
+        m_cellVertices[cellIndex(points[i])] = i;
+    }
+    /// Remove point from its grid cell
+    template <typename TPoints>
+    void removePoint(const VertInd i, const TPoints& points)
+    {
+        VertInd& cellVertex = m_cellVertices[cellIndex(points[i])];
+        if(cellVertex == i)
+            cellVertex = noVertex;
+    }
+    /// Find vertex in the same grid cell or the nearest grid vertex
+    template <typename TPoints>
+    VertInd nearPoint(const V2d<T>& pos, const TPoints& /*points*/) const
+    {
+        const VertInd iV = m_cellVertices[cellIndex(pos)];
+        if(iV != noVertex)
+            return iV;
+        const std::size_t ix =
+            clampedTick((pos.x - m_min.x) * m_xCellsPerUnit + T(0.5), m_xres);
+        const std::size_t iy =
+            clampedTick((pos.y - m_min.y) * m_yCellsPerUnit + T(0.5), m_yres);
+        return VertInd(iy * (m_xres + 1) + ix);
+    }
+
+private:
+    /// Integer part of a non-negative value clamped to [0, max]
+    static std::size_t clampedTick(const T value, const std::size_t max)
+    {
+        return value > T(0) ? std::min(std::size_t(value), max) : 0;
+    }
+    std::size_t cellIndex(const V2d<T>& pos) const
+    {
+        const std::size_t ix =
+            clampedTick((pos.x - m_min.x) * m_xCellsPerUnit, m_xres - 1);
+        const std::size_t iy =
+            clampedTick((pos.y - m_min.y) * m_yCellsPerUnit, m_yres - 1);
+        return iy * m_xres + ix;
+    }
+
+    V2d<T> m_min;
+    T m_xCellsPerUnit;
+    T m_yCellsPerUnit;
+    std::size_t m_xres;
+    std::size_t m_yres;
+    std::vector<VertInd> m_cellVertices; ///< last added vertex in each cell
+};
+
 } // namespace CDT
 
 #endif
@@ -0,0 +1,434 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+/**
+ * @file
+ * Helper functions for saving and loading triangulation in a compact binary
+ * format
+ *
+ * Format (native byte order, every section is padded to 8 bytes):
+ *  - header: detail::BinaryHeader
+ *  - vertices: nVertices x V2d<T>
+ *  - triangles: nTriangles x Triangle (vertices followed by neighbors)
+ *  - vertices' adjacent triangles: nVertTris x TriInd, one triangle per
+ *    vertex; empty for finalized triangulations
+ *  - fixed edges: nFixedEdges x (v1, v2)
+ *  - overlap counts: nOverlapCount x (v1, v2, count)
+ *  - split edges: nPieceToOriginals x (v1, v2, number of originals)
+ *    followed by nOriginals x (v1, v2) of all the originals
+ *
+ * All the indices are stored as IndexSizeType. Vertices and triangles can be
+ * used in place from memory (e.g., memory-mapped file) with readBinaryView.
+ */
+
+#ifndef CDT_t9QfRKyJb2Xw5sVmLc0D
+#define CDT_t9QfRKyJb2Xw5sVmLc0D
+
+#include <CDT.h>
+
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace CDT
+{
+namespace detail
+{
+
+/// Version of binary format: increase on incompatible changes
+const unsigned long long binaryFormatVersion = 1;
+
+/// Header of binary format
+struct BinaryHeader
+{
+    char magic[8];                        ///< "CDTBIN" padded with zeros
+    unsigned long long version;           ///< binary format version
+    unsigned long long coordSize;         ///< size of coordinate in bytes
+    unsigned long long indexSize;         ///< size of index in bytes
+    unsigned long long superGeomType;     ///< SuperGeometryType::Enum
+    unsigned long long nSuperGeomVerts;   ///< vertices of super-geometry
+    unsigned long long nVertices;         ///< number of vertices
+    unsigned long long nTriangles;        ///< number of triangles
+    unsigned long long nVertTris;         ///< vertices' adjacent triangles
+    unsigned long long nFixedEdges;       ///< number of fixed edges
+    unsigned long long nOverlapCount;     ///< number of overlap counts
+    unsigned long long nPieceToOriginals; ///< number of split edges
+    unsigned long long nOriginals;        ///< originals of all split edges
+};
+
+const char binaryMagic[8] = {'C', 'D', 'T', 'B', 'I', 'N', '\0', '\0'};
+
+/// Bytes to add to a section to align the next section to 8 bytes
+inline std::size_t binaryPadding(const std::size_t sectionSize)
+{
+    return (8 - sectionSize % 8) % 8;
+}
+
+/// Write padding after a section that was written element by element
+inline void writeBinaryPadding(std::ostream& out, const std::size_t size)
+{
+    static const char zeros[8] = {0};
+    out.write(zeros, binaryPadding(size));
+}
+
+/// Write a section of raw data followed by padding
+inline void writeBinarySection(
+    std::ostream& out,
+    const void* const data,
+    const std::size_t size)
+{
+    if(size)
+        out.write(static_cast<const char*>(data), size);
+    writeBinaryPadding(out, size);
+}
+
+/// Read a section of raw data and skip padding
+inline void
+readBinarySection(std::istream& in, void* const data, const std::size_t size)
+{
+    char padding[8];
+    if(size)
+        in.read(static_cast<char*>(data), size);
+    in.read(padding, binaryPadding(size));
+    if(!in)
+        throw std::runtime_error("Unexpected end of binary triangulation");
+}
+
+/// Check that header describes data of the given coordinate type
+template <typename T>
+void checkBinaryHeader(const BinaryHeader& h)
+{
+    if(std::memcmp(h.magic, binaryMagic, sizeof(binaryMagic)) != 0)
+        throw std::runtime_error("Not a binary triangulation");
+    if(h.version != binaryFormatVersion)
+        throw std::runtime_error("Unsupported binary triangulation version");
+    if(h.coordSize != sizeof(T) || h.indexSize != sizeof(IndexSizeType))
+    {
+        throw std::runtime_error(
+            "Binary triangulation has different coordinate or index type");
+    }
+}
+
+/**
+ * Make loaded triangulation that was not finalized editable: calculate
+ * vertices' adjacent triangles if they were not loaded and initialize
+ * super-geometry
+ */
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void initializeLoadedTriangulation(
+    Triangulation<T, TNearPointLocator, TAllocator>& cdt,
+    const SuperGeometryType::Enum superGeomType,
+    const std::size_t nSuperGeomVerts)
+{
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    if(cdt.vertTris.empty())
+    {
+        cdt.vertTris.assign(cdt.vertices.size(), noNeighbor);
+        for(TriInd iT(0); iT < TriInd(cdt.triangles.size()); ++iT)
+        {
+            const VerticesArr3& vv = cdt.triangles[iT].vertices;
+            for(Index i(0); i < Index(3); ++i)
+                cdt.vertTris[vv[i]] = iT;
+        }
+    }
+#else
+    // lists of all adjacent triangles are not stored
+    typedef typename Triangulation<T, TNearPointLocator, TAllocator>::
+        AdjacentTriangles AdjacentTriangles;
+    cdt.vertTris.assign(cdt.vertices.size(), AdjacentTriangles());
+    for(TriInd iT(0); iT < TriInd(cdt.triangles.size()); ++iT)
+    {
+        const VerticesArr3& vv = cdt.triangles[iT].vertices;
+        for(Index i(0); i < Index(3); ++i)
+            cdt.vertTris[vv[i]].push_back(iT);
+    }
+#endif
+    cdt.initializedWithSuperGeometry(superGeomType, nSuperGeomVerts);
+}
+
+} // namespace detail
+
+/**
+ * Save triangulation in binary format
+ * @details Data is streamed to the output without making intermediate
+ * copies.
+ * @tparam T type of vertex coordinates (e.g., float, double)
+ * @tparam TNearPointLocator class providing locating near point
+ * @tparam TAllocator allocator of triangulation's containers
+ * @param out output stream opened in binary mode
+ * @param cdt triangulation to save
+ */
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void writeBinary(
+    std::ostream& out,
+    const Triangulation<T, TNearPointLocator, TAllocator>& cdt)
+{
+    typedef IndexSizeType I;
+    typedef Triangulation<T, TNearPointLocator, TAllocator> Cdt;
+    detail::BinaryHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, detail::binaryMagic, sizeof(h.magic));
+    h.version = detail::binaryFormatVersion;
+    h.coordSize = sizeof(T);
+    h.indexSize = sizeof(I);
+    h.superGeomType = cdt.superGeometryType();
+    h.nSuperGeomVerts = cdt.superGeometryVertexCount();
+    h.nVertices = cdt.vertices.size();
+    h.nTriangles = cdt.triangles.size();
+    h.nVertTris = cdt.isFinalized() ? 0 : cdt.vertices.size();
+    h.nFixedEdges = cdt.fixedEdges.size();
+    h.nOverlapCount = cdt.overlapCount.size();
+    h.nPieceToOriginals = cdt.pieceToOriginals.size();
+    typedef typename Cdt::PieceToOriginals::const_iterator PieceCit;
+    for(PieceCit it = cdt.pieceToOriginals.begin();
+        it != cdt.pieceToOriginals.end();
+        ++it)
+    {
+        h.nOriginals += it->second.size();
+    }
+    detail::writeBinarySection(out, &h, sizeof(h));
+
+    detail::writeBinarySection(
+        out,
+        cdt.vertices.empty() ? NULL : &cdt.vertices[0],
+        cdt.vertices.size() * sizeof(V2d<T>));
+    detail::writeBinarySection(
+        out,
+        cdt.triangles.empty() ? NULL : &cdt.triangles[0],
+        cdt.triangles.size() * sizeof(Triangle));
+    for(VertInd iV(0); iV < VertInd(h.nVertTris); ++iV)
+    {
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+        const I iT = cdt.vertTris[iV];
+#else
+        const I iT = cdt.vertTris[iV].empty() ? I(noNeighbor)
+                                              : I(cdt.vertTris[iV].front());
+#endif
+        out.write(reinterpret_cast<const char*>(&iT), sizeof(I));
+    }
+    detail::writeBinaryPadding(out, h.nVertTris * sizeof(I));
+    typedef typename Cdt::FixedEdges::const_iterator FixedCit;
+    for(FixedCit it = cdt.fixedEdges.begin();
+        it != cdt.fixedEdges.end();
+        ++it)
+    {
+        const I e[2] = {it->v1(), it->v2()};
+        out.write(reinterpret_cast<const char*>(e), sizeof(e));
+    }
+    detail::writeBinaryPadding(out, h.nFixedEdges * 2 * sizeof(I));
+    typedef typename Cdt::OverlapCounts::const_iterator OverlapCit;
+    for(OverlapCit it = cdt.overlapCount.begin();
+        it != cdt.overlapCount.end();
+        ++it)
+    {
+        const I e[3] = {it->first.v1(), it->first.v2(), I(it->second)};
+        out.write(reinterpret_cast<const char*>(e), sizeof(e));
+    }
+    detail::writeBinaryPadding(out, h.nOverlapCount * 3 * sizeof(I));
+    for(PieceCit it = cdt.pieceToOriginals.begin();
+        it != cdt.pieceToOriginals.end();
+        ++it)
+    {
+        const I e[3] = {it->first.v1(), it->first.v2(), I(it->second.size())};
+        out.write(reinterpret_cast<const char*>(e), sizeof(e));
+    }
+    detail::writeBinaryPadding(out, h.nPieceToOriginals * 3 * sizeof(I));
+    for(PieceCit it = cdt.pieceToOriginals.begin();
+        it != cdt.pieceToOriginals.end();
+        ++it)
+    {
+        for(EdgeVec::const_iterator e = it->second.begin();
+            e != it->second.end();
+            ++e)
+        {
+            const I ee[2] = {e->v1(), e->v2()};
+            out.write(reinterpret_cast<const char*>(ee), sizeof(ee));
+        }
+    }
+    detail::writeBinaryPadding(out, h.nOriginals * 2 * sizeof(I));
+    if(!out)
+        throw std::runtime_error("Failed to write binary triangulation");
+}
+
+/**
+ * Load triangulation saved with CDT::writeBinary
+ * @details Vertices' adjacent triangles are loaded instead of re-calculated.
+ * Loaded triangulation that was not finalized can be edited further.
+ * @tparam T type of vertex coordinates (e.g., float, double)
+ * @tparam TNearPointLocator class providing locating near point
+ * @tparam TAllocator allocator of triangulation's containers
+ * @param in input stream opened in binary mode
+ * @param cdt triangulation to load into: its previous content is replaced
+ */
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void readBinary(
+    std::istream& in,
+    Triangulation<T, TNearPointLocator, TAllocator>& cdt)
+{
+    typedef IndexSizeType I;
+    detail::BinaryHeader h;
+    detail::readBinarySection(in, &h, sizeof(h));
+    detail::checkBinaryHeader<T>(h);
+
+    cdt.vertices.resize(h.nVertices);
+    detail::readBinarySection(
+        in,
+        cdt.vertices.empty() ? NULL : &cdt.vertices[0],
+        cdt.vertices.size() * sizeof(V2d<T>));
+    cdt.triangles.resize(h.nTriangles);
+    detail::readBinarySection(
+        in,
+        cdt.triangles.empty() ? NULL : &cdt.triangles[0],
+        cdt.triangles.size() * sizeof(Triangle));
+    std::vector<I> buf(h.nVertTris);
+    detail::readBinarySection(
+        in, buf.empty() ? NULL : &buf[0], buf.size() * sizeof(I));
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    cdt.vertTris.assign(buf.begin(), buf.end());
+#else
+    cdt.vertTris.clear();
+#endif
+
+    buf.resize(h.nFixedEdges * 2);
+    detail::readBinarySection(
+        in, buf.empty() ? NULL : &buf[0], buf.size() * sizeof(I));
+    cdt.fixedEdges.clear();
+    cdt.fixedEdges.reserve(h.nFixedEdges);
+    for(std::size_t i = 0; i < buf.size(); i += 2)
+        cdt.fixedEdges.insert(Edge(VertInd(buf[i]), VertInd(buf[i + 1])));
+
+    buf.resize(h.nOverlapCount * 3);
+    detail::readBinarySection(
+        in, buf.empty() ? NULL : &buf[0], buf.size() * sizeof(I));
+    cdt.overlapCount.clear();
+    for(std::size_t i = 0; i < buf.size(); i += 3)
+    {
+        cdt.overlapCount.insert(std::make_pair(
+            Edge(VertInd(buf[i]), VertInd(buf[i + 1])),
+            BoundaryOverlapCount(buf[i + 2])));
+    }
+
+    buf.resize(h.nPieceToOriginals * 3);
+    detail::readBinarySection(
+        in, buf.empty() ? NULL : &buf[0], buf.size() * sizeof(I));
+    std::vector<I> originals(h.nOriginals * 2);
+    detail::readBinarySection(
+        in,
+        originals.empty() ? NULL : &originals[0],
+        originals.size() * sizeof(I));
+    // numbers of pieces' originals must add up to the number of originals
+    unsigned long long nOriginalsLeft = h.nOriginals;
+    for(std::size_t i = 0; i < buf.size(); i += 3)
+    {
+        if(buf[i + 2] > nOriginalsLeft)
+            throw std::runtime_error("Corrupted binary triangulation");
+        nOriginalsLeft -= buf[i + 2];
+    }
+    if(nOriginalsLeft != 0)
+        throw std::runtime_error("Corrupted binary triangulation");
+    cdt.pieceToOriginals.clear();
+    std::vector<I>::const_iterator itOriginal = originals.begin();
+    for(std::size_t i = 0; i < buf.size(); i += 3)
+    {
+        EdgeVec& ee = cdt.pieceToOriginals[Edge(
+            VertInd(buf[i]), VertInd(buf[i + 1]))];
+        ee.reserve(buf[i + 2]);
+        for(I j = 0; j < buf[i + 2]; ++j, itOriginal += 2)
+            ee.push_back(Edge(VertInd(itOriginal[0]), VertInd(itOriginal[1])));
+    }
+
+    if(h.nVertTris)
+    {
+        detail::initializeLoadedTriangulation(
+            cdt,
+            SuperGeometryType::Enum(h.superGeomType),
+            std::size_t(h.nSuperGeomVerts));
+    }
+}
+
+/**
+ * View of binary triangulation's data in memory
+ * @details Arrays point into the binary data: they are valid as long as the
+ * data is.
+ */
+template <typename T>
+struct BinaryTriangulationView
+{
+    const V2d<T>* vertices;          ///< triangulation's vertices
+    std::size_t nVertices;           ///< number of vertices
+    const Triangle* triangles;       ///< triangulation's triangles
+    std::size_t nTriangles;          ///< number of triangles
+    const IndexSizeType* fixedEdges; ///< pairs of fixed edges' vertices
+    std::size_t nFixedEdges;         ///< number of fixed edges
+};
+
+/**
+ * Use vertices, triangles and fixed edges of binary triangulation in place
+ * without parsing or copying (e.g., from memory-mapped file)
+ * @tparam T type of vertex coordinates (e.g., float, double)
+ * @param data beginning of data saved with CDT::writeBinary: must be aligned
+ * to 8 bytes
+ * @param size size of data in bytes
+ */
+template <typename T>
+BinaryTriangulationView<T>
+readBinaryView(const void* const data, const std::size_t size)
+{
+    typedef IndexSizeType I;
+    const char* const p = static_cast<const char*>(data);
+    if(size < sizeof(detail::BinaryHeader))
+        throw std::runtime_error("Unexpected end of binary triangulation");
+    detail::BinaryHeader h;
+    std::memcpy(&h, p, sizeof(h));
+    detail::checkBinaryHeader<T>(h);
+
+    BinaryTriangulationView<T> view;
+    const unsigned long long counts[] = {
+        h.nVertices,
+        h.nTriangles,
+        h.nVertTris,
+        h.nFixedEdges,
+        h.nOverlapCount,
+        h.nPieceToOriginals,
+        h.nOriginals};
+    const std::size_t elementSizes[] = {
+        sizeof(V2d<T>),
+        sizeof(Triangle),
+        sizeof(I),
+        2 * sizeof(I),
+        3 * sizeof(I),
+        3 * sizeof(I),
+        2 * sizeof(I)};
+    const int nSections = sizeof(counts) / sizeof(counts[0]);
+    const char* sections[nSections];
+    std::size_t offset = sizeof(h);
+    for(int i = 0; i < nSections; ++i)
+    {
+        // compare counts with remaining data before multiplying: corrupted
+        // counts can't overflow section sizes
+        if(counts[i] > (size - offset) / elementSizes[i])
+            throw std::runtime_error("Unexpected end of binary triangulation");
+        const std::size_t sectionSize =
+            static_cast<std::size_t>(counts[i]) * elementSizes[i];
+        sections[i] = p + offset;
+        offset += sectionSize;
+        if(detail::binaryPadding(sectionSize) > size - offset)
+            throw std::runtime_error("Unexpected end of binary triangulation");
+        offset += detail::binaryPadding(sectionSize);
+    }
+    view.vertices = reinterpret_cast<const V2d<T>*>(sections[0]);
+    view.nVertices = h.nVertices;
+    view.triangles = reinterpret_cast<const Triangle*>(sections[1]);
+    view.nTriangles = h.nTriangles;
+    view.fixedEdges = reinterpret_cast<const I*>(sections[3]);
+    view.nFixedEdges = h.nFixedEdges;
+    return view;
+}
+
+} // namespace CDT
+
+#endif
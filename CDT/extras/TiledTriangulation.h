@@ -0,0 +1,325 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+/**
+ * @file
+ * Streaming Delaunay triangulation of point sets that don't fit into memory.
+ * Points arrive in tiles ordered by x-coordinate, triangles are output as
+ * soon as no later point can change them.
+ */
+
+#ifndef CDT_z4WcLq8RmYs1TnEuHb7K
+#define CDT_z4WcLq8RmYs1TnEuHb7K
+
+#include <CDT.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stack>
+#include <vector>
+
+namespace CDT
+{
+namespace detail
+{
+
+/// Right-most x-coordinate of triangle's circumcircle
+template <typename T>
+T circumcircleMaxX(const V2d<T>& a, const V2d<T>& b, const V2d<T>& c)
+{
+    // circumcenter relative to the first vertex
+    const T bx = b.x - a.x, by = b.y - a.y;
+    const T cx = c.x - a.x, cy = c.y - a.y;
+    const T d = T(2) * (bx * cy - by * cx);
+    if(d == T(0))
+        return std::numeric_limits<T>::max();
+    const T b2 = bx * bx + by * by;
+    const T c2 = cx * cx + cy * cy;
+    const T ux = (cy * b2 - by * c2) / d;
+    const T uy = (bx * c2 - cx * b2) / d;
+    return a.x + ux + std::sqrt(ux * ux + uy * uy);
+}
+
+} // namespace detail
+
+/**
+ * Delaunay triangulation of points streamed in tiles (e.g., from disk)
+ *
+ * Tiles must be added in the order of increasing x-coordinate: for each tile
+ * a lower bound of x-coordinates in all the later tiles is given. A triangle
+ * is final when its circumcircle lies to the left of that bound: no later
+ * point can be inside of it. Final triangles are output and forgotten. Only
+ * vertices of triangles that are not final yet (the active frontier) are
+ * kept in memory.
+ *
+ * Each tile is triangulated together with the active frontier. Boundary of
+ * the already output region is inserted as constraint edges so that
+ * triangles near tile seams are the same as in the global Delaunay
+ * triangulation. Convex hull edges of the output region are forgotten once
+ * no later point can connect to their vertices.
+ *
+ * @note points must not contain duplicates
+ * @tparam T type of vertex coordinates (e.g., float, double)
+ */
+template <typename T>
+class TiledTriangulation
+{
+public:
+    /**
+     * Constructor
+     * @param box bounding box of all the points of all the tiles
+     */
+    explicit TiledTriangulation(const Box2d<T>& box)
+        : m_box(box)
+        , m_nextId(0)
+    {}
+
+    /**
+     * Add a tile of points and output triangles that became final
+     * @tparam TOutputIt output iterator of VerticesArr3
+     * @param points tile's points: they get consecutive indices continuing
+     * the indices of previous tiles' points
+     * @param nextTilesMinX lower bound of x-coordinates of all the points in
+     * tiles that are added later
+     * @param out receives final triangles: indices of three vertices in
+     * counter-clockwise order
+     * @return output iterator past the last written triangle
+     */
+    template <typename TOutputIt>
+    TOutputIt addTile(
+        const std::vector<V2d<T> >& points,
+        const T nextTilesMinX,
+        TOutputIt out)
+    {
+        m_vertices.insert(m_vertices.end(), points.begin(), points.end());
+        for(std::size_t i = 0; i < points.size(); ++i, ++m_nextId)
+            m_ids.push_back(m_nextId);
+        const T margin = (m_box.max.x - m_box.min.x + m_box.max.y -
+                          m_box.min.y) *
+                         std::numeric_limits<T>::epsilon() * T(64);
+        return triangulateFrontier(nextTilesMinX - margin, false, out);
+    }
+
+    /**
+     * Output all the remaining triangles after the last tile was added
+     * @tparam TOutputIt output iterator of VerticesArr3
+     * @param out receives the remaining triangles
+     * @return output iterator past the last written triangle
+     */
+    template <typename TOutputIt>
+    TOutputIt finish(TOutputIt out)
+    {
+        out = triangulateFrontier(std::numeric_limits<T>::max(), true, out);
+        m_vertices.clear();
+        m_ids.clear();
+        m_boundary.clear();
+        return out;
+    }
+
+    /// Number of vertices in the active frontier kept in memory
+    std::size_t activeVertexCount() const
+    {
+        return m_vertices.size();
+    }
+
+private:
+    /// Boundary edge and its start vertex: output region is to its left
+    typedef unordered_map<Edge, VertInd> BoundaryMap;
+
+    /**
+     * Triangulate the active frontier, output triangles with circumcircles
+     * to the left of a given x-coordinate (or all triangles) and keep
+     * vertices of the rest
+     */
+    template <typename TOutputIt>
+    TOutputIt triangulateFrontier(
+        const T finalMaxX,
+        const bool isAllFinal,
+        TOutputIt out)
+    {
+        if(m_vertices.size() < 3)
+            return out;
+        m_cdt.reset();
+        m_cdt.initializeSuperTriangle(m_box);
+        m_cdt.insertVertices(m_vertices);
+        // boundary of the output region: from global to frontier indices
+        unordered_map<VertInd, VertInd> toLocal;
+        for(std::size_t i = 0; i < m_ids.size(); ++i)
+            toLocal.insert(std::make_pair(m_ids[i], VertInd(i)));
+        EdgeVec boundary;
+        boundary.reserve(m_boundary.size());
+        for(BoundaryMap::const_iterator it = m_boundary.begin();
+            it != m_boundary.end();
+            ++it)
+        {
+            const Edge& e = it->first;
+            boundary.push_back(Edge(toLocal.at(e.v1()), toLocal.at(e.v2())));
+        }
+        m_cdt.insertEdges(boundary);
+
+        // already output region: flood from output sides of boundary edges
+        const std::size_t nST = 3; // super-triangle's vertices
+        const TriangleVec& tt = m_cdt.triangles;
+        std::vector<bool>& isOutput = m_isOutput;
+        isOutput.assign(tt.size(), false);
+        std::stack<TriInd> triStack;
+        for(TriInd iT(0); iT < TriInd(tt.size()); ++iT)
+        {
+            const VerticesArr3& vv = tt[iT].vertices;
+            if(vv[0] < nST || vv[1] < nST || vv[2] < nST)
+                continue;
+            for(Index i(0); i < Index(3); ++i)
+            {
+                const VertInd iV = m_ids[vv[i] - nST];
+                const BoundaryMap::const_iterator it = m_boundary.find(
+                    Edge(iV, m_ids[vv[ccw(i)] - nST]));
+                if(it != m_boundary.end() && it->second == iV)
+                {
+                    isOutput[iT] = true;
+                    triStack.push(iT);
+                    break;
+                }
+            }
+        }
+        while(!triStack.empty())
+        {
+            const Triangle& t = tt[triStack.top()];
+            triStack.pop();
+            for(Index i(0); i < Index(3); ++i)
+            {
+                const TriInd iN = t.neighbors[i];
+                if(iN == noNeighbor || isOutput[iN] ||
+                   m_cdt.fixedEdges.count(
+                       Edge(t.vertices[i], t.vertices[ccw(i)])))
+                {
+                    continue;
+                }
+                const VerticesArr3& vv = tt[iN].vertices;
+                if(vv[0] < nST || vv[1] < nST || vv[2] < nST)
+                    continue;
+                isOutput[iN] = true;
+                triStack.push(iN);
+            }
+        }
+
+        std::vector<bool> isActive(m_vertices.size(), false);
+        for(TriInd iT(0); iT < TriInd(tt.size()); ++iT)
+        {
+            const VerticesArr3& vv = tt[iT].vertices;
+            if(vv[0] < nST || vv[1] < nST || vv[2] < nST || isOutput[iT])
+                continue;
+            const std::vector<V2d<T> >& pp = m_cdt.vertices;
+            if(!isAllFinal &&
+               !(detail::circumcircleMaxX(pp[vv[0]], pp[vv[1]], pp[vv[2]]) <
+                 finalMaxX))
+            {
+                for(int i = 0; i < 3; ++i)
+                    isActive[vv[i] - nST] = true;
+                continue;
+            }
+            VerticesArr3 t;
+            for(int i = 0; i < 3; ++i)
+                t[i] = m_ids[vv[i] - nST];
+            *out++ = t;
+            // edges shared with output triangles are not boundary anymore;
+            // boundary edge is stored with the vertex it starts from when
+            // walking output triangle counter-clockwise
+            for(int i = 0; i < 3; ++i)
+            {
+                const Edge e(t[i], t[(i + 1) % 3]);
+                if(!m_boundary.erase(e))
+                    m_boundary.insert(std::make_pair(e, t[i]));
+            }
+        }
+        if(!isAllFinal)
+            eraseFinalHullEdges(finalMaxX, isActive);
+
+        // keep vertices of not yet final triangles and of the boundary
+        for(BoundaryMap::const_iterator it = m_boundary.begin();
+            it != m_boundary.end();
+            ++it)
+        {
+            isActive[toLocal.at(it->first.v1())] = true;
+            isActive[toLocal.at(it->first.v2())] = true;
+        }
+        std::size_t iNew = 0;
+        for(std::size_t i = 0; i < m_vertices.size(); ++i)
+        {
+            if(!isActive[i])
+                continue;
+            m_vertices[iNew] = m_vertices[i];
+            m_ids[iNew] = m_ids[i];
+            ++iNew;
+        }
+        m_vertices.resize(iNew);
+        m_ids.resize(iNew);
+        return out;
+    }
+
+    /**
+     * Forget convex hull edges of the output region when no later point can
+     * connect to their vertices: both vertices are only in final triangles
+     * and all later points are on the inner side of their hull edges
+     * @param finalMaxX lower bound of x-coordinates of all later points
+     * @param isActive marks vertices of not yet final triangles
+     */
+    void eraseFinalHullEdges(
+        const T finalMaxX,
+        const std::vector<bool>& isActive)
+    {
+        const std::size_t nST = 3; // super-triangle's vertices
+        const TriangleVec& tt = m_cdt.triangles;
+        const std::vector<V2d<T> >& pp = m_cdt.vertices;
+        // corners of the box containing all later points
+        const V2d<T> corners[] = {
+            V2d<T>::make(finalMaxX, m_box.min.y),
+            V2d<T>::make(finalMaxX, m_box.max.y),
+            V2d<T>::make(m_box.max.x, m_box.min.y),
+            V2d<T>::make(m_box.max.x, m_box.max.y)};
+        // hull edge is opposed to the only super-triangle's vertex: later
+        // points on that side of the edge would connect to its vertices
+        EdgeVec& hull = m_hullEdges;
+        hull.clear();
+        std::vector<bool> isReachable(isActive);
+        for(TriInd iT(0); iT < TriInd(tt.size()); ++iT)
+        {
+            const VerticesArr3& vv = tt[iT].vertices;
+            const int nSuper = (vv[0] < nST) + (vv[1] < nST) + (vv[2] < nST);
+            if(nSuper != 1)
+                continue;
+            const Index i = vv[0] < nST ? 0 : vv[1] < nST ? 1 : 2;
+            const VertInd iA = vv[ccw(i)], iB = vv[cw(i)];
+            hull.push_back(Edge(iA, iB));
+            for(int j = 0; j < 4; ++j)
+            {
+                if(locatePointLine(corners[j], pp[iA], pp[iB]) ==
+                   PtLineLocation::Left)
+                {
+                    isReachable[iA - nST] = isReachable[iB - nST] = true;
+                    break;
+                }
+            }
+        }
+        for(EdgeVec::const_iterator e = hull.begin(); e != hull.end(); ++e)
+        {
+            const VertInd iA = e->v1() - nST, iB = e->v2() - nST;
+            if(!isReachable[iA] && !isReachable[iB])
+                m_boundary.erase(Edge(m_ids[iA], m_ids[iB]));
+        }
+    }
+
+    Box2d<T> m_box;
+    std::vector<V2d<T> > m_vertices; ///< active frontier's vertices
+    std::vector<VertInd> m_ids;      ///< global indices of frontier vertices
+    BoundaryMap m_boundary; ///< boundary of output region (global indices)
+    VertInd m_nextId;       ///< global index of the next added point
+    Triangulation<T> m_cdt;
+    std::vector<bool> m_isOutput; ///< frontier's triangles in output region
+    EdgeVec m_hullEdges;          ///< frontier's convex hull edges
+};
+
+} // namespace CDT
+
+#endif
@@ -22,21 +22,60 @@ namespace CDT
  *
  * Checks:
  *  - for each vertex adjacent triangles contain the vertex
+ *    (with CDT_USE_COMPACT_VERTEX_ADJACENCY: vertex's single adjacent
+ *    triangle contains the vertex)
  *  - each triangle's neighbor in turn has triangle as its neighbor
  *  - each of triangle's vertices has triangle as adjacent
  *
  * @tparam T type of vertex coordinates (e.g., float, double)
  * @tparam TNearPointLocator class providing locating near point for efficiently
+ * @tparam TAllocator allocator of triangulation's containers
  */
-template <typename T, typename TNearPointLocator>
-inline bool verifyTopology(const CDT::Triangulation<T, TNearPointLocator>& cdt)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+inline bool verifyTopology(
+    const CDT::Triangulation<T, TNearPointLocator, TAllocator>& cdt)
 {
+    // triangulation's containers can have a custom allocator: copy triangles
+    const TriangleVec triangles(cdt.triangles.begin(), cdt.triangles.end());
     // Check if vertices' adjacent triangles contain vertex
-    const VerticesTriangles vertTris =
-        cdt.isFinalized()
-            ? calculateTrianglesByVertex(
-                  cdt.triangles, static_cast<VertInd>(cdt.vertices.size()))
-            : cdt.vertTris;
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    const VerticesTriangles vertTris = calculateTrianglesByVertex(
+        triangles, static_cast<VertInd>(cdt.vertices.size()));
+    if(!cdt.isFinalized())
+    {
+        for(VertInd iV(0); iV < VertInd(cdt.vertices.size()); ++iV)
+        {
+            const TriInd iT = cdt.vertTris[iV];
+            if(iT == noNeighbor) // only removed vertices have no triangles
+            {
+                if(!vertTris[iV].empty())
+                    return false;
+                continue;
+            }
+            if(iT >= TriInd(cdt.triangles.size()))
+                return false;
+            const array<VertInd, 3>& vv = cdt.triangles[iT].vertices;
+            if(std::find(vv.begin(), vv.end(), iV) == vv.end())
+                return false;
+        }
+    }
+#else
+    VerticesTriangles vertTris;
+    if(cdt.isFinalized())
+    {
+        vertTris = calculateTrianglesByVertex(
+            triangles, static_cast<VertInd>(cdt.vertices.size()));
+    }
+    else
+    {
+        vertTris.reserve(cdt.vertTris.size());
+        for(std::size_t iV = 0; iV < cdt.vertTris.size(); ++iV)
+        {
+            vertTris.push_back(
+                TriIndVec(cdt.vertTris[iV].begin(), cdt.vertTris[iV].end()));
+        }
+    }
+#endif
     for(VertInd iV(0); iV < VertInd(cdt.vertices.size()); ++iV)
     {
         const TriIndVec& vTris = vertTris[iV];
@@ -11,6 +11,8 @@
 #define CDT_lNrmUayWQaIR5fxnsg9B
 
 #include "CDTUtils.h"
+#include "LocatorBucketGrid.h"
+#include "LocatorLastInserted.h"
 #include "Triangulation.h"
 
 #include "remove_at.hpp"
@@ -43,6 +45,17 @@ typedef LayerDepth BoundaryOverlapCount;
 /// Triangles by vertex index
 typedef std::vector<TriIndVec> VerticesTriangles;
 
+/**
+ * Rows of vertex indices in flat compressed sparse row (CSR) arrays
+ * @details Row i consists of items[offsets[i]], ...,
+ * items[offsets[i + 1] - 1]
+ */
+struct CDT_EXPORT CsrVertices
+{
+    std::vector<std::size_t> offsets; ///< row starts and end of the last row
+    std::vector<VertInd> items;       ///< vertex indices of all the rows
+};
+
 /** @defgroup helpers Helpers
  *  Helpers for working with CDT::Triangulation.
  */
@@ -95,6 +108,36 @@ DuplicatesInfo FindDuplicates(
     TGetVertexCoordX getX,
     TGetVertexCoordY getY);
 
+/**
+ * Find duplicates in given custom point-type range using multiple threads
+ * @note duplicates are points with exactly same X and Y coordinates
+ * @note result is identical to the result of CDT::FindDuplicates. Points are
+ * sorted by position to find duplicates, sorting is split between threads.
+ * Without C++11 support a single thread is used.
+ * @tparam TVertexIter iterator that dereferences to custom point type
+ * @tparam TGetVertexCoordX function object getting x coordinate from vertex.
+ * Getter signature: const TVertexIter::value_type& -> T
+ * @tparam TGetVertexCoordY function object getting y coordinate from vertex.
+ * Getter signature: const TVertexIter::value_type& -> T
+ * @param first beginning of the range of vertices
+ * @param last end of the range of vertices
+ * @param getX getter of X-coordinate
+ * @param getY getter of Y-coordinate
+ * @param nThreads number of threads to use
+ * @returns information about vertex duplicates
+ */
+template <
+    typename T,
+    typename TVertexIter,
+    typename TGetVertexCoordX,
+    typename TGetVertexCoordY>
+DuplicatesInfo FindDuplicatesParallel(
+    TVertexIter first,
+    TVertexIter last,
+    TGetVertexCoordX getX,
+    TGetVertexCoordY getY,
+    std::size_t nThreads);
+
 /**
  * Remove duplicates in-place from vector of custom points
  * @tparam TVertex vertex type
@@ -147,6 +190,41 @@ CDT_EXPORT void RemapEdges(
     TGetEdgeVertexEnd getEnd,
     TMakeEdgeFromStartAndEnd makeEdge);
 
+/**
+ * Remap vertex indices in edges (in-place) using given vertex-index mapping
+ * and multiple threads: each thread remaps a part of the edge range.
+ * @note Without C++11 support a single thread is used.
+ * @tparam TEdgeIter random-access iterator that dereferences to custom edge
+ * type
+ * @tparam TGetEdgeVertexStart function object getting start vertex index
+ * from an edge.
+ * Getter signature: const TEdgeIter::value_type& -> CDT::VertInd
+ * @tparam TGetEdgeVertexEnd function object getting end vertex index from
+ * an edge. Getter signature: const TEdgeIter::value_type& -> CDT::VertInd
+ * @tparam TMakeEdgeFromStartAndEnd function object that makes new edge from
+ * start and end vertices
+ * @param first beginning of the range of edges
+ * @param last end of the range of edges
+ * @param mapping vertex-index mapping
+ * @param getStart getter of edge start vertex index
+ * @param getEnd getter of edge end vertex index
+ * @param makeEdge factory for making edge from vetices
+ * @param nThreads number of threads to use
+ */
+template <
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd,
+    typename TMakeEdgeFromStartAndEnd>
+void RemapEdgesParallel(
+    TEdgeIter first,
+    TEdgeIter last,
+    const std::vector<std::size_t>& mapping,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd,
+    TMakeEdgeFromStartAndEnd makeEdge,
+    std::size_t nThreads);
+
 /**
  * Remap vertex indices in edges (in-place) using given vertex-index mapping.
  *
@@ -219,6 +297,53 @@ CDT_EXPORT DuplicatesInfo RemoveDuplicatesAndRemapEdges(
     std::vector<V2d<T> >& vertices,
     std::vector<Edge>& edges);
 
+/**
+ * Same as CDT::RemoveDuplicatesAndRemapEdges but finds duplicates and remaps
+ * edges using multiple threads
+ * @note Same as a chained call of CDT::FindDuplicatesParallel,
+ * CDT::RemoveDuplicates, and CDT::RemapEdgesParallel
+ * @tparam TEdgeIter random-access iterator that dereferences to custom edge
+ * type
+ * @param nThreads number of threads to use
+ * @sa CDT::RemoveDuplicatesAndRemapEdges for description of other parameters
+ * @returns information about vertex duplicates
+ */
+template <
+    typename T,
+    typename TVertex,
+    typename TGetVertexCoordX,
+    typename TGetVertexCoordY,
+    typename TVertexAllocator,
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd,
+    typename TMakeEdgeFromStartAndEnd>
+DuplicatesInfo RemoveDuplicatesAndRemapEdgesParallel(
+    std::vector<TVertex, TVertexAllocator>& vertices,
+    TGetVertexCoordX getX,
+    TGetVertexCoordY getY,
+    TEdgeIter edgesFirst,
+    TEdgeIter edgesLast,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd,
+    TMakeEdgeFromStartAndEnd makeEdge,
+    std::size_t nThreads);
+
+/**
+ * Same as a chained call of CDT::FindDuplicatesParallel,
+ * CDT::RemoveDuplicates, and CDT::RemapEdgesParallel
+ *
+ * @tparam T type of vertex coordinates (e.g., float, double)
+ * @param[in, out] vertices collection of vertices to remove duplicates from
+ * @param[in,out] edges collection of edges to remap
+ * @param nThreads number of threads to use
+ */
+template <typename T>
+CDT_EXPORT DuplicatesInfo RemoveDuplicatesAndRemapEdgesParallel(
+    std::vector<V2d<T> >& vertices,
+    std::vector<Edge>& edges,
+    std::size_t nThreads);
+
 /**
  * Extract all edges of triangles
  *
@@ -248,6 +373,59 @@ CDT_EXPORT unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
     const unordered_map<Edge, EdgeVec>& edgeToPieces,
     const std::vector<V2d<T> >& vertices);
 
+/**
+ * @defgroup extraction Parallel Mesh Extraction
+ * Flat mesh data extracted from triangles using multiple threads.
+ * Output is sized with prefix sums of per-thread counts, no hashing is
+ * used. Triangles are only read: extraction can run concurrently with other
+ * extractions and queries on the same triangulation.
+ */
+/// @{
+
+/**
+ * Extract all edges of triangles using multiple threads
+ * @details Each edge is reported by the triangle with the smaller index out
+ * of the two triangles sharing it
+ * @param triangles triangles used to extract edges
+ * @param nThreads number of threads to use
+ * @return unique edges ordered by triangles reporting them
+ */
+CDT_EXPORT EdgeVec extractEdgesFromTrianglesParallel(
+    const TriangleVec& triangles,
+    std::size_t nThreads);
+
+/**
+ * Extract boundary loops of triangles: chains of edges with a triangle on
+ * only one side
+ * @details Boundary edges are collected using multiple threads, loops are
+ * traced by rotating around their vertices.
+ * @param triangles triangles used to extract boundary loops
+ * @param nThreads number of threads to use
+ * @return a row of vertices for each loop. Triangles are on the left side
+ * when traversing the loop: outer boundaries are counter-clockwise, holes
+ * are clockwise. The first vertex is not repeated at the end.
+ */
+CDT_EXPORT CsrVertices extractBoundaryLoopsParallel(
+    const TriangleVec& triangles,
+    std::size_t nThreads);
+
+/**
+ * Extract one-ring neighbors of each vertex
+ * @details Rows are sized by a prefix sum of neighbor counts, filled in one
+ * pass over triangles, and sorted using multiple threads.
+ * @param triangles triangles used to extract vertex neighbors
+ * @param verticesSize total number of vertices
+ * @param nThreads number of threads to use
+ * @return a row for each vertex with indices of its neighbors in the
+ * ascending order. Vertices not used by triangles have empty rows.
+ */
+CDT_EXPORT CsrVertices extractVertexNeighborsParallel(
+    const TriangleVec& triangles,
+    VertInd verticesSize,
+    std::size_t nThreads);
+
+/// @}
+
 /// @}
 
 /// @}
@@ -282,6 +460,105 @@ struct hash<CDT::V2d<T> >
 namespace CDT
 {
 
+namespace detail
+{
+
+/// Minimal number of items processed by a separate thread
+const std::size_t minParallelChunkSize = 4096;
+
+/// Vertex position and vertex index: sorted when looking for duplicates
+template <typename T>
+struct PosAndIndex
+{
+    T x;           ///< X-coordinate
+    T y;           ///< Y-coordinate
+    std::size_t i; ///< vertex index
+};
+
+/// Order by position then by index: first occurrence of a position is first
+template <typename T>
+struct LessPosAndIndex
+{
+    bool operator()(const PosAndIndex<T>& a, const PosAndIndex<T>& b) const
+    {
+        if(a.x != b.x)
+            return a.x < b.x;
+        if(a.y != b.y)
+            return a.y < b.y;
+        return a.i < b.i;
+    }
+};
+
+template <typename TIter, typename TCompare>
+void sortRange(const TIter first, const TIter last, const TCompare comp)
+{
+    std::sort(first, last, comp);
+}
+
+template <typename TIter, typename TCompare>
+void mergeRanges(
+    const TIter first,
+    const TIter middle,
+    const TIter last,
+    const TCompare comp)
+{
+    std::inplace_merge(first, middle, last, comp);
+}
+
+/**
+ * Sort a range using multiple threads: chunks of the range are sorted
+ * concurrently and then merged pairwise
+ */
+template <typename TIter, typename TCompare>
+void sortParallel(
+    const TIter first,
+    const TIter last,
+    const TCompare comp,
+    const std::size_t nThreads)
+{
+    const std::size_t n = last - first;
+    const std::size_t nChunks = std::min(nThreads, n / minParallelChunkSize);
+    if(nChunks < 2)
+        return sortRange(first, last, comp);
+#ifdef CDT_CXX11_IS_SUPPORTED
+    std::vector<TIter> bounds;
+    bounds.reserve(nChunks + 1);
+    for(std::size_t k = 0; k <= nChunks; ++k)
+        bounds.push_back(first + n * k / nChunks);
+    ThreadGroup threads(nChunks - 1);
+    for(std::size_t k = 1; k < nChunks; ++k)
+    {
+        threads.run(std::bind(
+            &sortRange<TIter, TCompare>, bounds[k], bounds[k + 1], comp));
+    }
+    sortRange(bounds[0], bounds[1], comp);
+    threads.join();
+    // merge neighboring sorted chunks until one chunk is left
+    while(bounds.size() > 2)
+    {
+        std::vector<TIter> mergedBounds(1, first);
+        for(std::size_t k = 0; k + 2 < bounds.size(); k += 2)
+        {
+            threads.run(std::bind(
+                &mergeRanges<TIter, TCompare>,
+                bounds[k],
+                bounds[k + 1],
+                bounds[k + 2],
+                comp));
+            mergedBounds.push_back(bounds[k + 2]);
+        }
+        if(bounds.size() % 2 == 0) // odd number of chunks: last is not merged
+            mergedBounds.push_back(bounds.back());
+        threads.join();
+        bounds.swap(mergedBounds);
+    }
+#else
+    sortRange(first, last, comp);
+#endif
+}
+
+} // namespace detail
+
 //-----
 // API
 //-----
@@ -296,23 +573,51 @@ DuplicatesInfo FindDuplicates(
     TGetVertexCoordX getX,
     TGetVertexCoordY getY)
 {
-    typedef unordered_map<V2d<T>, std::size_t> PosToIndex;
-    PosToIndex uniqueVerts;
+    return FindDuplicatesParallel<T>(first, last, getX, getY, 1);
+}
+
+template <
+    typename T,
+    typename TVertexIter,
+    typename TGetVertexCoordX,
+    typename TGetVertexCoordY>
+DuplicatesInfo FindDuplicatesParallel(
+    TVertexIter first,
+    TVertexIter last,
+    TGetVertexCoordX getX,
+    TGetVertexCoordY getY,
+    const std::size_t nThreads)
+{
+    typedef detail::PosAndIndex<T> PosAndIndex;
     const std::size_t verticesSize = std::distance(first, last);
+    std::vector<PosAndIndex> sorted(verticesSize);
+    for(std::size_t i = 0; i < verticesSize; ++i, ++first)
+    {
+        sorted[i].x = getX(*first);
+        sorted[i].y = getY(*first);
+        sorted[i].i = i;
+    }
+    detail::sortParallel(
+        sorted.begin(), sorted.end(), detail::LessPosAndIndex<T>(), nThreads);
+    // map each vertex to the first vertex with the same position
     DuplicatesInfo di = {
         std::vector<std::size_t>(verticesSize), std::vector<std::size_t>()};
-    for(std::size_t iIn = 0, iOut = iIn; iIn < verticesSize; ++iIn, ++first)
+    typedef typename std::vector<PosAndIndex>::const_iterator Cit;
+    for(Cit it = sorted.begin(), itFirst = it; it != sorted.end(); ++it)
     {
-        typename PosToIndex::const_iterator it;
-        bool isUnique;
-        tie(it, isUnique) = uniqueVerts.insert(
-            std::make_pair(V2d<T>::make(getX(*first), getY(*first)), iOut));
-        if(isUnique)
+        if(it->x != itFirst->x || it->y != itFirst->y)
+            itFirst = it;
+        di.mapping[it->i] = itFirst->i;
+    }
+    // first occurrences come first: re-map to indices of unique vertices
+    for(std::size_t iIn = 0, iOut = iIn; iIn < verticesSize; ++iIn)
+    {
+        if(di.mapping[iIn] == iIn)
         {
             di.mapping[iIn] = iOut++;
             continue;
         }
-        di.mapping[iIn] = it->second; // found a duplicate
+        di.mapping[iIn] = di.mapping[di.mapping[iIn]]; // found a duplicate
         di.duplicates.push_back(iIn);
     }
     return di;
@@ -353,6 +658,49 @@ void RemapEdges(
     }
 }
 
+template <
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd,
+    typename TMakeEdgeFromStartAndEnd>
+void RemapEdgesParallel(
+    const TEdgeIter first,
+    const TEdgeIter last,
+    const std::vector<std::size_t>& mapping,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd,
+    TMakeEdgeFromStartAndEnd makeEdge,
+    const std::size_t nThreads)
+{
+    const std::size_t n = last - first;
+    const std::size_t nChunks =
+        std::min(nThreads, n / detail::minParallelChunkSize);
+    if(nChunks < 2)
+        return RemapEdges(first, last, mapping, getStart, getEnd, makeEdge);
+#ifdef CDT_CXX11_IS_SUPPORTED
+    detail::ThreadGroup threads(nChunks - 1);
+    for(std::size_t k = 1; k < nChunks; ++k)
+    {
+        threads.run(std::bind(
+            &RemapEdges<
+                TEdgeIter,
+                TGetEdgeVertexStart,
+                TGetEdgeVertexEnd,
+                TMakeEdgeFromStartAndEnd>,
+            first + n * k / nChunks,
+            first + n * (k + 1) / nChunks,
+            std::cref(mapping),
+            getStart,
+            getEnd,
+            makeEdge));
+    }
+    RemapEdges(first, first + n / nChunks, mapping, getStart, getEnd, makeEdge);
+    threads.join();
+#else
+    RemapEdges(first, last, mapping, getStart, getEnd, makeEdge);
+#endif
+}
+
 template <
     typename T,
     typename TVertex,
@@ -380,6 +728,41 @@ DuplicatesInfo RemoveDuplicatesAndRemapEdges(
     return di;
 }
 
+template <
+    typename T,
+    typename TVertex,
+    typename TGetVertexCoordX,
+    typename TGetVertexCoordY,
+    typename TVertexAllocator,
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd,
+    typename TMakeEdgeFromStartAndEnd>
+DuplicatesInfo RemoveDuplicatesAndRemapEdgesParallel(
+    std::vector<TVertex, TVertexAllocator>& vertices,
+    TGetVertexCoordX getX,
+    TGetVertexCoordY getY,
+    const TEdgeIter edgesFirst,
+    const TEdgeIter edgesLast,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd,
+    TMakeEdgeFromStartAndEnd makeEdge,
+    const std::size_t nThreads)
+{
+    const DuplicatesInfo di = FindDuplicatesParallel<T>(
+        vertices.begin(), vertices.end(), getX, getY, nThreads);
+    RemoveDuplicates(vertices, di.duplicates);
+    RemapEdgesParallel(
+        edgesFirst,
+        edgesLast,
+        di.mapping,
+        getStart,
+        getEnd,
+        makeEdge,
+        nThreads);
+    return di;
+}
+
 template <typename T>
 unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
     const unordered_map<Edge, EdgeVec>& edgeToPieces,
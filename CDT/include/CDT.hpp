@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <functional>
 #include <limits>
 #include <stdexcept>
 
@@ -70,6 +71,24 @@ DuplicatesInfo RemoveDuplicatesAndRemapEdges(
         edge_make);
 }
 
+template <typename T>
+DuplicatesInfo RemoveDuplicatesAndRemapEdgesParallel(
+    std::vector<V2d<T> >& vertices,
+    std::vector<Edge>& edges,
+    const std::size_t nThreads)
+{
+    return RemoveDuplicatesAndRemapEdgesParallel<T>(
+        vertices,
+        getX_V2d<T>,
+        getY_V2d<T>,
+        edges.begin(),
+        edges.end(),
+        edge_get_v1,
+        edge_get_v2,
+        edge_make,
+        nThreads);
+}
+
 CDT_INLINE_IF_HEADER_ONLY EdgeUSet
 extractEdgesFromTriangles(const TriangleVec& triangles)
 {
@@ -104,4 +123,296 @@ EdgeToPiecesMapping(const unordered_map<Edge, EdgeVec>& pieceToOriginals)
     return originalToPieces;
 }
 
+namespace detail
+{
+
+/// Which half-edges (triangle-edge pairs) are collected
+struct HalfEdgeSelection
+{
+    /// Enum
+    enum Enum
+    {
+        Unique,   ///< one half-edge per edge: from triangle with smaller index
+        Boundary, ///< half-edges without triangle on the other side
+    };
+};
+
+/// Half-edge encoded as 3 * triangle index + edge index in triangle
+typedef std::size_t HalfEdge;
+
+/// Number of chunks of items processed by separate threads
+CDT_INLINE_IF_HEADER_ONLY std::size_t
+parallelChunkCount(const std::size_t n, const std::size_t nThreads)
+{
+    return std::max(
+        std::min(nThreads, n / minParallelChunkSize), std::size_t(1));
+}
+
+/**
+ * Call f(iChunk, first, last) for each of nChunks equal chunks of items
+ * [0, n): each chunk is processed by a separate thread
+ */
+template <typename TFunc>
+void forEachChunk(
+    const std::size_t n,
+    const std::size_t nChunks,
+    const TFunc& f)
+{
+#ifdef CDT_CXX11_IS_SUPPORTED
+    ThreadGroup threads(nChunks - 1);
+    for(std::size_t k = 1; k < nChunks; ++k)
+    {
+        threads.run(
+            std::bind(std::cref(f), k, n * k / nChunks, n * (k + 1) / nChunks));
+    }
+    f(0, 0, n / nChunks);
+    threads.join();
+#else
+    for(std::size_t k = 0; k < nChunks; ++k)
+        f(k, n * k / nChunks, n * (k + 1) / nChunks);
+#endif
+}
+
+/**
+ * Count selected half-edges of a chunk of triangles or, if output is given,
+ * write them at chunk's offset
+ */
+class CollectHalfEdges
+{
+public:
+    CollectHalfEdges(
+        const TriangleVec& triangles,
+        const HalfEdgeSelection::Enum selection,
+        std::vector<std::size_t>& chunkCounts,
+        HalfEdge* const out)
+        : m_triangles(triangles)
+        , m_selection(selection)
+        , m_chunkCounts(chunkCounts)
+        , m_out(out)
+    {}
+    void operator()(
+        const std::size_t iChunk,
+        const std::size_t first,
+        const std::size_t last) const
+    {
+        std::size_t n = 0;
+        HalfEdge* const out = m_out ? m_out + m_chunkCounts[iChunk] : NULL;
+        for(std::size_t iT = first; iT < last; ++iT)
+        {
+            const NeighborsArr3& nn = m_triangles[iT].neighbors;
+            for(Index i(0); i < Index(3); ++i)
+            {
+                const bool isSelected =
+                    m_selection == HalfEdgeSelection::Boundary
+                        ? nn[i] == noNeighbor
+                        : nn[i] == noNeighbor || iT < nn[i];
+                if(!isSelected)
+                    continue;
+                if(out)
+                    out[n] = HalfEdge(3 * iT + i);
+                ++n;
+            }
+        }
+        if(!out)
+            m_chunkCounts[iChunk] = n;
+    }
+
+private:
+    const TriangleVec& m_triangles;
+    HalfEdgeSelection::Enum m_selection;
+    std::vector<std::size_t>& m_chunkCounts;
+    HalfEdge* m_out;
+};
+
+/// Collect selected half-edges: count, prefix-sum the counts, write
+CDT_INLINE_IF_HEADER_ONLY std::vector<HalfEdge> collectHalfEdges(
+    const TriangleVec& triangles,
+    const HalfEdgeSelection::Enum selection,
+    const std::size_t nThreads)
+{
+    const std::size_t nTris = triangles.size();
+    const std::size_t nChunks = parallelChunkCount(nTris, nThreads);
+    std::vector<std::size_t> chunkCounts(nChunks);
+    forEachChunk(
+        nTris,
+        nChunks,
+        CollectHalfEdges(triangles, selection, chunkCounts, NULL));
+    // exclusive prefix sum: counts become chunks' offsets
+    std::size_t nHalfEdges = 0;
+    for(std::size_t k = 0; k < nChunks; ++k)
+    {
+        const std::size_t count = chunkCounts[k];
+        chunkCounts[k] = nHalfEdges;
+        nHalfEdges += count;
+    }
+    std::vector<HalfEdge> halfEdges(nHalfEdges);
+    if(nHalfEdges == 0)
+        return halfEdges;
+    forEachChunk(
+        nTris,
+        nChunks,
+        CollectHalfEdges(triangles, selection, chunkCounts, &halfEdges[0]));
+    return halfEdges;
+}
+
+/// Convert a chunk of half-edges to edges
+class HalfEdgesToEdges
+{
+public:
+    HalfEdgesToEdges(
+        const TriangleVec& triangles,
+        const std::vector<HalfEdge>& halfEdges,
+        EdgeVec& edges)
+        : m_triangles(triangles)
+        , m_halfEdges(halfEdges)
+        , m_edges(edges)
+    {}
+    void operator()(
+        const std::size_t /*iChunk*/,
+        const std::size_t first,
+        const std::size_t last) const
+    {
+        for(std::size_t i = first; i < last; ++i)
+        {
+            const VerticesArr3& vv = m_triangles[m_halfEdges[i] / 3].vertices;
+            const Index iEdge(m_halfEdges[i] % 3);
+            m_edges[i] = Edge(vv[iEdge], vv[ccw(iEdge)]);
+        }
+    }
+
+private:
+    const TriangleVec& m_triangles;
+    const std::vector<HalfEdge>& m_halfEdges;
+    EdgeVec& m_edges;
+};
+
+/// Boundary half-edge starting at the end of a given boundary half-edge
+CDT_INLINE_IF_HEADER_ONLY HalfEdge
+nextBoundaryHalfEdge(const TriangleVec& triangles, const HalfEdge h)
+{
+    // rotate around the end vertex until reaching the boundary
+    TriInd iT(h / 3);
+    Index i = ccw(Index(h % 3));
+    const VertInd v = triangles[iT].vertices[i];
+    while(triangles[iT].neighbors[i] != noNeighbor)
+    {
+        iT = triangles[iT].neighbors[i];
+        i = vertexInd(triangles[iT], v);
+    }
+    return HalfEdge(3 * iT + i);
+}
+
+/// Sort rows of a chunk of vertices
+class SortCsrRows
+{
+public:
+    explicit SortCsrRows(CsrVertices& csr)
+        : m_csr(csr)
+    {}
+    void operator()(
+        const std::size_t /*iChunk*/,
+        const std::size_t first,
+        const std::size_t last) const
+    {
+        const std::vector<VertInd>::iterator items = m_csr.items.begin();
+        for(std::size_t i = first; i < last; ++i)
+        {
+            std::sort(
+                items + m_csr.offsets[i], items + m_csr.offsets[i + 1]);
+        }
+    }
+
+private:
+    CsrVertices& m_csr;
+};
+
+} // namespace detail
+
+CDT_INLINE_IF_HEADER_ONLY EdgeVec extractEdgesFromTrianglesParallel(
+    const TriangleVec& triangles,
+    const std::size_t nThreads)
+{
+    const std::vector<detail::HalfEdge> halfEdges = detail::collectHalfEdges(
+        triangles, detail::HalfEdgeSelection::Unique, nThreads);
+    EdgeVec edges(halfEdges.size(), Edge(noVertex, noVertex));
+    detail::forEachChunk(
+        halfEdges.size(),
+        detail::parallelChunkCount(halfEdges.size(), nThreads),
+        detail::HalfEdgesToEdges(triangles, halfEdges, edges));
+    return edges;
+}
+
+CDT_INLINE_IF_HEADER_ONLY CsrVertices extractBoundaryLoopsParallel(
+    const TriangleVec& triangles,
+    const std::size_t nThreads)
+{
+    const std::vector<detail::HalfEdge> halfEdges = detail::collectHalfEdges(
+        triangles, detail::HalfEdgeSelection::Boundary, nThreads);
+    CsrVertices loops;
+    loops.offsets.push_back(0);
+    loops.items.reserve(halfEdges.size());
+    std::vector<bool> isTraced(triangles.size() * 3, false);
+    typedef std::vector<detail::HalfEdge>::const_iterator Cit;
+    for(Cit it = halfEdges.begin(); it != halfEdges.end(); ++it)
+    {
+        if(isTraced[*it])
+            continue;
+        detail::HalfEdge h = *it;
+        do
+        {
+            isTraced[h] = true;
+            loops.items.push_back(triangles[h / 3].vertices[h % 3]);
+            h = detail::nextBoundaryHalfEdge(triangles, h);
+        } while(h != *it);
+        loops.offsets.push_back(loops.items.size());
+    }
+    return loops;
+}
+
+CDT_INLINE_IF_HEADER_ONLY CsrVertices extractVertexNeighborsParallel(
+    const TriangleVec& triangles,
+    const VertInd verticesSize,
+    const std::size_t nThreads)
+{
+    // Vertex's neighbors are ends of half-edges starting at the vertex and
+    // starts of boundary half-edges ending at the vertex
+    const std::vector<detail::HalfEdge> boundary = detail::collectHalfEdges(
+        triangles, detail::HalfEdgeSelection::Boundary, nThreads);
+    CsrVertices neighbors;
+    std::vector<std::size_t>& offsets = neighbors.offsets;
+    offsets.assign(std::size_t(verticesSize) + 1, 0);
+    typedef TriangleVec::const_iterator TCit;
+    typedef std::vector<detail::HalfEdge>::const_iterator HCit;
+    for(TCit t = triangles.begin(); t != triangles.end(); ++t)
+        for(Index i(0); i < Index(3); ++i)
+            ++offsets[t->vertices[i] + 1];
+    for(HCit h = boundary.begin(); h != boundary.end(); ++h)
+    {
+        const VerticesArr3& vv = triangles[*h / 3].vertices;
+        ++offsets[vv[ccw(Index(*h % 3))] + 1];
+    }
+    // prefix sum of neighbor counts: rows' offsets
+    for(std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+    neighbors.items.resize(offsets.back());
+    std::vector<std::size_t> ends(offsets.begin(), offsets.end() - 1);
+    for(TCit t = triangles.begin(); t != triangles.end(); ++t)
+    {
+        const VerticesArr3& vv = t->vertices;
+        for(Index i(0); i < Index(3); ++i)
+            neighbors.items[ends[vv[i]]++] = vv[ccw(i)];
+    }
+    for(HCit h = boundary.begin(); h != boundary.end(); ++h)
+    {
+        const VerticesArr3& vv = triangles[*h / 3].vertices;
+        const Index i(*h % 3);
+        neighbors.items[ends[vv[ccw(i)]]++] = vv[i];
+    }
+    detail::forEachChunk(
+        verticesSize,
+        detail::parallelChunkCount(verticesSize, nThreads),
+        detail::SortCsrRows(neighbors));
+    return neighbors;
+}
+
 } // namespace CDT
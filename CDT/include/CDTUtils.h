@@ -40,8 +40,10 @@ typedef char couldnt_parse_cxx_standard[-1]; ///< Error: couldn't parse standard
 #define CDT_EXPORT
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <vector>
 
@@ -53,8 +55,11 @@ typedef char couldnt_parse_cxx_standard[-1]; ///< Error: couldn't parse standard
 #ifdef CDT_CXX11_IS_SUPPORTED
 
 #include <array>
+#include <exception>
 #include <functional>
+#include <mutex>
 #include <random>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -156,6 +161,202 @@ typedef std::vector<TriInd> TriIndVec;  ///< Vector of triangle indices
 typedef array<VertInd, 3> VerticesArr3; ///< array of three vertex indices
 typedef array<TriInd, 3> NeighborsArr3; ///< array of three neighbors
 
+#ifdef CDT_ENABLE_STATS
+/**
+ * Counters of events on the hot paths of triangulation
+ * @note only available if CDT_ENABLE_STATS is defined
+ */
+struct CDT_EXPORT TriangulationStats
+{
+    std::size_t walkSteps;          ///< triangles visited by triangle walks
+    std::size_t kdTreeNodesVisited; ///< KD-tree nodes visited by queries
+    std::size_t flips;              ///< edge flips restoring Delaunay property
+    std::size_t pseudopolygons;     ///< triangulated pseudo-polygons
+    /// maximal depth of pseudo-polygon triangulation sub-tasks
+    std::size_t pseudopolygonMaxDepth;
+    std::size_t conformingSplits; ///< edges split by conforming to edges
+    /// predicates that left the fast floating-point path
+    std::size_t predicateSlowPaths;
+
+    /// Constructor: all counters are zero
+    TriangulationStats()
+        : walkSteps(0)
+        , kdTreeNodesVisited(0)
+        , flips(0)
+        , pseudopolygons(0)
+        , pseudopolygonMaxDepth(0)
+        , conformingSplits(0)
+        , predicateSlowPaths(0)
+    {}
+    /// Add counters of other stats
+    TriangulationStats& operator+=(const TriangulationStats& other)
+    {
+        walkSteps += other.walkSteps;
+        kdTreeNodesVisited += other.kdTreeNodesVisited;
+        flips += other.flips;
+        pseudopolygons += other.pseudopolygons;
+        pseudopolygonMaxDepth =
+            std::max(pseudopolygonMaxDepth, other.pseudopolygonMaxDepth);
+        conformingSplits += other.conformingSplits;
+        predicateSlowPaths += other.predicateSlowPaths;
+        return *this;
+    }
+};
+
+namespace detail
+{
+
+/// Stats collected by the current thread, null if not collected
+inline TriangulationStats*& currentStats()
+{
+#ifdef CDT_CXX11_IS_SUPPORTED
+    static thread_local TriangulationStats* stats = NULL;
+#else
+    static TriangulationStats* stats = NULL;
+#endif
+    return stats;
+}
+
+/**
+ * Collects stats of the current thread into given stats while in scope
+ * @note nested scopes collect into the stats of the outermost scope
+ */
+class StatsScope
+{
+public:
+    /// Start collecting stats of the current thread
+    explicit StatsScope(TriangulationStats& stats)
+        : m_isOutermost(currentStats() == NULL)
+    {
+        if(m_isOutermost)
+            currentStats() = &stats;
+    }
+    /// Stop collecting stats of the current thread
+    ~StatsScope()
+    {
+        if(m_isOutermost)
+            currentStats() = NULL;
+    }
+
+private:
+    bool m_isOutermost;
+};
+
+} // namespace detail
+
+/// Add value to a counter of the stats collected by the current thread
+#define CDT_STATS_ADD(counter, value)                                          \
+    do                                                                         \
+    {                                                                          \
+        if(CDT::TriangulationStats* const cdtStats_ =                          \
+               CDT::detail::currentStats())                                    \
+            cdtStats_->counter += (value);                                     \
+    } while(false)
+/// Raise a counter of the stats collected by the current thread to a value
+#define CDT_STATS_MAX(counter, value)                                          \
+    do                                                                         \
+    {                                                                          \
+        if(CDT::TriangulationStats* const cdtStats_ =                          \
+               CDT::detail::currentStats())                                    \
+            cdtStats_->counter = std::max<std::size_t>(                        \
+                cdtStats_->counter, (value));                                  \
+    } while(false)
+#else
+#define CDT_STATS_ADD(counter, value)
+#define CDT_STATS_MAX(counter, value)
+#endif
+
+#ifdef CDT_CXX11_IS_SUPPORTED
+namespace detail
+{
+
+/**
+ * Threads running tasks concurrently with the calling thread
+ * @details Exception thrown by a task is caught in its thread and the first
+ * one is re-thrown by ThreadGroup::join, like a serial call would throw it.
+ * Threads are also joined on destruction: an exception thrown in the calling
+ * thread doesn't leave joinable threads behind (std::terminate otherwise).
+ */
+class ThreadGroup
+{
+public:
+    /// Constructor: reserves space for a number of threads
+    explicit ThreadGroup(const std::size_t nThreads)
+    {
+        m_threads.reserve(nThreads);
+    }
+    /// Join remaining threads: exceptions of their tasks are dropped
+    ~ThreadGroup()
+    {
+        joinThreads();
+    }
+    /// Run a task callable without arguments in a new thread
+    template <typename TTask>
+    void run(const TTask& task)
+    {
+        m_threads.push_back(std::thread(GuardedTask<TTask>(task, *this)));
+    }
+    /// Wait for all tasks and re-throw the first exception thrown by a task
+    void join()
+    {
+        joinThreads();
+        if(!m_error)
+            return;
+        const std::exception_ptr error = m_error;
+        m_error = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+
+private:
+    ThreadGroup(const ThreadGroup&);
+    ThreadGroup& operator=(const ThreadGroup&);
+
+    /// Task wrapper storing exceptions of the task in the group
+    template <typename TTask>
+    struct GuardedTask
+    {
+        GuardedTask(const TTask& task, ThreadGroup& group)
+            : task(task)
+            , group(&group)
+        {}
+        void operator()()
+        {
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                group->setError(std::current_exception());
+            }
+        }
+        TTask task;
+        ThreadGroup* group;
+    };
+
+    void setError(const std::exception_ptr& error)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_error)
+            m_error = error;
+    }
+    void joinThreads()
+    {
+        typedef std::vector<std::thread>::iterator ThreadIt;
+        for(ThreadIt it = m_threads.begin(); it != m_threads.end(); ++it)
+            if(it->joinable())
+                it->join();
+        m_threads.clear();
+    }
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::exception_ptr m_error; ///< first exception thrown by a task
+};
+
+} // namespace detail
+#endif
+
 /// 2D bounding box
 template <typename T>
 struct CDT_EXPORT Box2d
@@ -305,6 +506,25 @@ CDT_EXPORT bool isOnEdge(PtTriLocation::Enum location);
 /// \note Call only if located on the edge!
 CDT_EXPORT Index edgeNeighbor(PtTriLocation::Enum location);
 
+/// Triangle containing a point and the point's location on it
+struct CDT_EXPORT TriangleLocation
+{
+    TriInd triangle;              ///< triangle, noNeighbor if none found
+    PtTriLocation::Enum location; ///< Outside if no triangle was found
+
+    /**
+     * Factory method
+     * @note needed for c++03 compatibility (no uniform initialization
+     * available)
+     */
+    static TriangleLocation
+    make(const TriInd triangle, const PtTriLocation::Enum location)
+    {
+        const TriangleLocation out = {triangle, location};
+        return out;
+    }
+};
+
 /// Relative location of point to a line
 struct CDT_EXPORT PtLineLocation
 {
@@ -321,6 +541,25 @@ struct CDT_EXPORT PtLineLocation
 template <typename T>
 CDT_EXPORT T orient2D(const V2d<T>& p, const V2d<T>& v1, const V2d<T>& v2);
 
+/**
+ * Orient point p against many lines v1[i]-v2[i]: batched robust predicate
+ * @note results are identical to calling orient2D for each line, but
+ * floating-point filter is evaluated in vectorization-friendly chunks and
+ * exact arithmetic is only used for the uncertain results
+ * @param p point to orient
+ * @param v1 first points of the lines
+ * @param v2 second points of the lines
+ * @param n number of lines
+ * @param[out] out n orientations
+ */
+template <typename T>
+CDT_EXPORT void orient2D(
+    const V2d<T>& p,
+    const V2d<T>* v1,
+    const V2d<T>* v2,
+    std::size_t n,
+    T* out);
+
 /// Check if point lies to the left of, to the right of, or on a line
 template <typename T>
 CDT_EXPORT PtLineLocation::Enum locatePointLine(
@@ -384,6 +623,28 @@ CDT_EXPORT bool isInCircumcircle(
     const V2d<T>& v2,
     const V2d<T>& v3);
 
+/**
+ * Test if point lies in circumscribed circles of many triangles: batched
+ * robust predicate
+ * @note results are identical to calling isInCircumcircle for each triangle,
+ * but floating-point filter is evaluated in vectorization-friendly chunks and
+ * exact arithmetic is only used for the uncertain results
+ * @param p point to test
+ * @param v1 first vertices of the triangles
+ * @param v2 second vertices of the triangles
+ * @param v3 third vertices of the triangles
+ * @param n number of triangles
+ * @param[out] out n results: true if point is inside of a circumcircle
+ */
+template <typename T>
+CDT_EXPORT void isInCircumcircle(
+    const V2d<T>& p,
+    const V2d<T>* v1,
+    const V2d<T>* v2,
+    const V2d<T>* v3,
+    std::size_t n,
+    bool* out);
+
 /// Test if two vertices share at least one common triangle
 CDT_EXPORT CDT_INLINE_IF_HEADER_ONLY bool
 verticesShareEdge(const TriIndVec& aTris, const TriIndVec& bTris);
@@ -9,8 +9,14 @@
 
 #include "CDTUtils.h"
 
+#ifdef CDT_ENABLE_STATS
+#define PREDICATES_ON_SLOW_PATH() CDT_STATS_ADD(predicateSlowPaths, 1)
+#endif
 #include "predicates.h" // robust predicates: orient, in-circle
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <stdexcept>
 
 namespace CDT
@@ -93,12 +99,141 @@ CDT_INLINE_IF_HEADER_ONLY Index edgeNeighbor(const PtTriLocation::Enum location)
     return static_cast<Index>(location - PtTriLocation::OnEdge1);
 }
 
+namespace detail
+{
+
+/// Half of machine epsilon: unit round-off used by Shewchuk's error bounds
+template <typename T>
+inline T unitRoundoff()
+{
+    return std::numeric_limits<T>::epsilon() / T(2);
+}
+
+/// Static error bound of orient2d's floating-point stage (ccwerrboundA)
+template <typename T>
+inline T orient2dErrBound()
+{
+    const T eps = unitRoundoff<T>();
+    return (T(3) + T(16) * eps) * eps;
+}
+
+/// Static error bound of incircle's floating-point stage (iccerrboundA)
+template <typename T>
+inline T incircleErrBound()
+{
+    const T eps = unitRoundoff<T>();
+    return (T(10) + T(96) * eps) * eps;
+}
+
+/**
+ * Floating-point stage of orient2d for coordinates relative to the point
+ * @param[out] errBound determinant's sign is certain if |det| >= errBound
+ * @return determinant: positive if point is to the left of the line
+ */
+template <typename T>
+inline T orient2dFilter(
+    const T acx,
+    const T acy,
+    const T bcx,
+    const T bcy,
+    T& errBound)
+{
+    const T detleft = acx * bcy;
+    const T detright = acy * bcx;
+    errBound = orient2dErrBound<T>() * std::abs(detleft + detright);
+    return detleft - detright;
+}
+
+/**
+ * Floating-point stage of incircle for coordinates relative to the point
+ * @param[out] errBound determinant's sign is certain if |det| >= errBound
+ * @return determinant: positive if point is inside of the circumcircle
+ */
+template <typename T>
+inline T incircleFilter(
+    const T adx,
+    const T ady,
+    const T bdx,
+    const T bdy,
+    const T cdx,
+    const T cdy,
+    T& errBound)
+{
+    const T bdxcdy = bdx * cdy;
+    const T cdxbdy = cdx * bdy;
+    const T cdxady = cdx * ady;
+    const T adxcdy = adx * cdy;
+    const T adxbdy = adx * bdy;
+    const T bdxady = bdx * ady;
+    const T alift = adx * adx + ady * ady;
+    const T blift = bdx * bdx + bdy * bdy;
+    const T clift = cdx * cdx + cdy * cdy;
+    const T permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                        (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                        (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+    errBound = incircleErrBound<T>() * permanent;
+    return alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) +
+           clift * (adxbdy - bdxady);
+}
+
+/// Size of the chunks processed by the batched predicates
+const std::size_t predicatesBatchSize = 64;
+
+} // namespace detail
+
 template <typename T>
 T orient2D(const V2d<T>& p, const V2d<T>& v1, const V2d<T>& v2)
 {
+    // Floating-point filter: same as the first stage of adaptive predicate,
+    // exact arithmetic is only used when the sign of det is uncertain
+    T errBound;
+    const T det = detail::orient2dFilter(
+        v1.x - p.x, v1.y - p.y, v2.x - p.x, v2.y - p.y, errBound);
+    if(std::abs(det) >= errBound)
+        return det;
     return predicates::adaptive::orient2d(v1.x, v1.y, v2.x, v2.y, p.x, p.y);
 }
 
+template <typename T>
+void orient2D(
+    const V2d<T>& p,
+    const V2d<T>* const v1,
+    const V2d<T>* const v2,
+    const std::size_t n,
+    T* const out)
+{
+    bool isUncertain[detail::predicatesBatchSize];
+    for(std::size_t iChunk = 0; iChunk < n;
+        iChunk += detail::predicatesBatchSize)
+    {
+        const std::size_t chunkSize =
+            std::min(detail::predicatesBatchSize, n - iChunk);
+        // branch-free pass: vectorizable
+        for(std::size_t i = 0; i < chunkSize; ++i)
+        {
+            const std::size_t j = iChunk + i;
+            T errBound;
+            const T det = detail::orient2dFilter(
+                v1[j].x - p.x,
+                v1[j].y - p.y,
+                v2[j].x - p.x,
+                v2[j].y - p.y,
+                errBound);
+            out[j] = det;
+            isUncertain[i] = std::abs(det) < errBound;
+        }
+        // rare uncertain results are re-computed with exact arithmetic
+        for(std::size_t i = 0; i < chunkSize; ++i)
+        {
+            if(!isUncertain[i])
+                continue;
+            const std::size_t j = iChunk + i;
+            out[j] = predicates::adaptive::orient2d(
+                v1[j].x, v1[j].y, v2[j].x, v2[j].y, p.x, p.y);
+        }
+    }
+}
+
 template <typename T>
 PtLineLocation::Enum locatePointLine(
     const V2d<T>& p,
@@ -237,10 +372,73 @@ bool isInCircumcircle(
     const V2d<T>& v2,
     const V2d<T>& v3)
 {
+    // Floating-point filter: same as the first stage of adaptive predicate,
+    // exact arithmetic is only used when the sign of det is uncertain
+    T errBound;
+    const T det = detail::incircleFilter(
+        v1.x - p.x,
+        v1.y - p.y,
+        v2.x - p.x,
+        v2.y - p.y,
+        v3.x - p.x,
+        v3.y - p.y,
+        errBound);
+    if(std::abs(det) >= errBound)
+        return det > T(0);
     using namespace predicates::adaptive;
     return incircle(v1.x, v1.y, v2.x, v2.y, v3.x, v3.y, p.x, p.y) > T(0);
 }
 
+template <typename T>
+void isInCircumcircle(
+    const V2d<T>& p,
+    const V2d<T>* const v1,
+    const V2d<T>* const v2,
+    const V2d<T>* const v3,
+    const std::size_t n,
+    bool* const out)
+{
+    bool isUncertain[detail::predicatesBatchSize];
+    for(std::size_t iChunk = 0; iChunk < n;
+        iChunk += detail::predicatesBatchSize)
+    {
+        const std::size_t chunkSize =
+            std::min(detail::predicatesBatchSize, n - iChunk);
+        // branch-free pass: vectorizable
+        for(std::size_t i = 0; i < chunkSize; ++i)
+        {
+            const std::size_t j = iChunk + i;
+            T errBound;
+            const T det = detail::incircleFilter(
+                v1[j].x - p.x,
+                v1[j].y - p.y,
+                v2[j].x - p.x,
+                v2[j].y - p.y,
+                v3[j].x - p.x,
+                v3[j].y - p.y,
+                errBound);
+            out[j] = det > T(0);
+            isUncertain[i] = std::abs(det) < errBound;
+        }
+        // rare uncertain results are re-computed with exact arithmetic
+        for(std::size_t i = 0; i < chunkSize; ++i)
+        {
+            if(!isUncertain[i])
+                continue;
+            const std::size_t j = iChunk + i;
+            out[j] = predicates::adaptive::incircle(
+                         v1[j].x,
+                         v1[j].y,
+                         v2[j].x,
+                         v2[j].y,
+                         v3[j].x,
+                         v3[j].y,
+                         p.x,
+                         p.y) > T(0);
+        }
+    }
+}
+
 CDT_INLINE_IF_HEADER_ONLY
 bool verticesShareEdge(const TriIndVec& aTris, const TriIndVec& bTris)
 {
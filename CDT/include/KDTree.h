@@ -9,7 +9,9 @@
 
 #include "CDTUtils.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <limits>
 
 namespace KDTree
@@ -27,6 +29,7 @@ struct NodeSplitDirection
 /// Simple tree structure with alternating half splitting nodes
 /// @details Simple tree structure
 ///          - Tree to incrementally add points to the structure.
+///          - Bulk-load all points at once into a balanced tree.
 ///          - Get the nearest point to a given input.
 ///          - Does not check for duplicates, expect unique points.
 /// @tparam TCoordType type used for storing point coordinate.
@@ -56,12 +59,13 @@ public:
     struct Node
     {
         children_type children; ///< two children if not leaf; {0,0} if leaf
+        coord_type split;       ///< split coordinate if not leaf
         point_data_vec data;    ///< points' data if leaf
         /// Create empty leaf
         Node()
+            : split(0)
         {
             setChildren(0, 0);
-            data.reserve(NumVerticesInLeaf);
         }
         /// Children setter for convenience
         void setChildren(const node_index c1, const node_index c2)
@@ -105,9 +109,10 @@ public:
     /// Insert a point into kd-tree
     /// @note external point-buffer is used to reduce kd-tree's memory footprint
     /// @param iPoint index of point in external point-buffer
+    /// @tparam TPoints vector of points (with any allocator)
     /// @param points external point-buffer
-    void
-    insert(const point_index& iPoint, const std::vector<point_type>& points)
+    template <typename TPoints>
+    void insert(const point_index& iPoint, const TPoints& points)
     {
         // if point is outside root, extend tree by adding new roots
         const point_type& pos = points[iPoint];
@@ -133,23 +138,29 @@ public:
                 point_data_vec& pd = m_nodes[node].data;
                 if(pd.size() < NumVerticesInLeaf)
                 {
+                    if(pd.empty())
+                        pd.reserve(NumVerticesInLeaf);
                     pd.push_back(iPoint);
                     return;
                 }
                 // initialize bbox first time the root capacity is reached
                 if(!m_isRootBoxInitialized)
                 {
-                    initializeRootBox(points);
+                    initializeRootBox(points, pd);
                     min = m_min;
                     max = m_max;
                 }
-                // split a full leaf node
+                // split a full leaf node in the middle
+                mid = midSplit(min, max, dir);
                 calcSplitInfo(min, max, dir, mid, newDir, newMin, newMax);
                 const node_index c1 = addNewNode(), c2 = addNewNode();
                 Node& n = m_nodes[node];
                 n.setChildren(c1, c2);
+                n.split = mid;
                 point_data_vec& c1data = m_nodes[c1].data;
                 point_data_vec& c2data = m_nodes[c2].data;
+                c1data.reserve(NumVerticesInLeaf);
+                c2data.reserve(NumVerticesInLeaf);
                 // move node's points to children
                 for(pd_cit it = n.data.begin(); it != n.data.end(); ++it)
                 {
@@ -161,6 +172,7 @@ public:
             }
             else
             {
+                mid = m_nodes[node].split;
                 calcSplitInfo(min, max, dir, mid, newDir, newMin, newMax);
             }
             // add the point to a child
@@ -171,13 +183,127 @@ public:
         }
     }
 
+    /// Remove a point from kd-tree
+    /// @note nodes are not merged when points are removed
+    /// @param iPoint index of point in external point-buffer
+    /// @tparam TPoints vector of points (with any allocator)
+    /// @param points external point-buffer
+    template <typename TPoints>
+    void remove(const point_index& iPoint, const TPoints& points)
+    {
+        const point_type& pos = points[iPoint];
+        node_index node = m_root;
+        point_type min = m_min;
+        point_type max = m_max;
+        NodeSplitDirection::Enum dir = m_rootDir;
+        // below: initialized only to suppress warnings
+        NodeSplitDirection::Enum newDir(NodeSplitDirection::X);
+        point_type newMin, newMax;
+        while(!m_nodes[node].isLeaf())
+        {
+            const coord_type mid = m_nodes[node].split;
+            calcSplitInfo(min, max, dir, mid, newDir, newMin, newMax);
+            const std::size_t iChild = whichChild(pos, mid, dir);
+            iChild == 0 ? max = newMax : min = newMin;
+            node = m_nodes[node].children[iChild];
+            dir = newDir;
+        }
+        point_data_vec& pd = m_nodes[node].data;
+        const point_data_vec::iterator it =
+            std::find(pd.begin(), pd.end(), iPoint);
+        if(it != pd.end())
+            pd.erase(it);
+    }
+
+    /// Build balanced kd-tree containing all points of a point-buffer at once
+    /// @details nodes are split at median point (found with nth_element)
+    /// instead of the middle of the node's box; tree's previous content is
+    /// discarded. Points can be added incrementally with KDTree::insert after
+    /// the bulk-load.
+    /// @note external point-buffer is used to reduce kd-tree's memory footprint
+    /// @tparam TPoints vector of points (with any allocator)
+    /// @param points external point-buffer
+    template <typename TPoints>
+    void bulkLoad(const TPoints& points)
+    {
+        m_nodes.clear();
+        m_rootDir = NodeSplitDirection::X;
+        m_root = addNewNode();
+        if(points.empty())
+        {
+            m_min = point_type::make(
+                -std::numeric_limits<coord_type>::max(),
+                -std::numeric_limits<coord_type>::max());
+            m_max = point_type::make(
+                std::numeric_limits<coord_type>::max(),
+                std::numeric_limits<coord_type>::max());
+            m_isRootBoxInitialized = false;
+            return;
+        }
+        point_data_vec ii(points.size());
+        for(point_index i = 0; i < point_index(ii.size()); ++i)
+            ii[i] = i;
+        initializeRootBox(points, ii);
+        m_nodes.reserve(4 * ii.size() / NumVerticesInLeaf + 1);
+
+        typedef point_data_vec::iterator pd_it;
+        std::vector<BulkLoadTask> tasks(
+            1, BulkLoadTask(m_root, ii.begin(), ii.end(), m_rootDir, 0));
+        while(!tasks.empty())
+        {
+            const BulkLoadTask t = tasks.back();
+            tasks.pop_back();
+            const std::ptrdiff_t nPoints = t.last - t.first;
+            if(nPoints <= static_cast<std::ptrdiff_t>(NumVerticesInLeaf))
+            {
+                m_nodes[t.node].data.assign(t.first, t.last);
+                continue;
+            }
+            // points equal to split coordinate belong to the first child
+            const pd_it median = t.first + nPoints / 2;
+            const CompareCoord lessCoord(&points[0], t.dir);
+            std::nth_element(t.first, median, t.last, lessCoord);
+            coord_type split = lessCoord.coord(*median);
+            pd_it middle =
+                std::partition(t.first, t.last, NotGreater(lessCoord, split));
+            if(middle == t.last)
+            {
+                // upper half has same coordinate as median: split before it
+                middle =
+                    std::partition(t.first, t.last, Less(lessCoord, split));
+                if(middle != t.first)
+                    split = lessCoord.coord(
+                        *std::max_element(t.first, middle, lessCoord));
+                else
+                    middle = t.last; // all coordinates are the same
+            }
+            // no split is possible in both directions: points coincide
+            const std::size_t nFlat = middle == t.last ? t.nFlatSplits + 1 : 0;
+            if(nFlat > 1)
+            {
+                m_nodes[t.node].data.assign(t.first, t.last);
+                continue;
+            }
+            const node_index c1 = addNewNode(), c2 = addNewNode();
+            Node& n = m_nodes[t.node];
+            n.setChildren(c1, c2);
+            n.split = split;
+            const NodeSplitDirection::Enum newDir =
+                t.dir == NodeSplitDirection::X ? NodeSplitDirection::Y
+                                               : NodeSplitDirection::X;
+            tasks.push_back(BulkLoadTask(c2, middle, t.last, newDir, 0));
+            tasks.push_back(BulkLoadTask(c1, t.first, middle, newDir, nFlat));
+        }
+    }
+
     /// Query kd-tree for a nearest neighbor point
     /// @note external point-buffer is used to reduce kd-tree's memory footprint
     /// @param point query point position
+    /// @tparam TPoints vector of points (with any allocator)
     /// @param points external point-buffer
-    value_type nearest(
-        const point_type& point,
-        const std::vector<point_type>& points) const
+    template <typename TPoints>
+    value_type
+    nearest(const point_type& point, const TPoints& points) const
     {
         value_type out;
         int iTask = -1;
@@ -189,6 +315,7 @@ public:
             const NearestTask t = m_tasksStack[iTask--];
             if(t.distSq > minDistSq)
                 continue;
+            CDT_STATS_ADD(kdTreeNodesVisited, 1);
             const Node& n = m_nodes[t.node];
             if(n.isLeaf())
             {
@@ -206,7 +333,7 @@ public:
             }
             else
             {
-                coord_type mid(0);
+                const coord_type mid = n.split;
                 NodeSplitDirection::Enum newDir;
                 point_type newMin, newMax;
                 calcSplitInfo(t.min, t.max, t.dir, mid, newDir, newMin, newMax);
@@ -262,12 +389,22 @@ private:
             dir == NodeSplitDirection::X ? point.x > split : point.y > split);
     }
 
-    /// Calculate split location, direction, and children boxes
+    /// Calculate location of the split in the middle of a box
+    static coord_type midSplit(
+        const point_type& min,
+        const point_type& max,
+        const NodeSplitDirection::Enum dir)
+    {
+        return dir == NodeSplitDirection::X ? (min.x + max.x) / coord_type(2)
+                                            : (min.y + max.y) / coord_type(2);
+    }
+
+    /// Calculate children's split direction and boxes for a given split
     static void calcSplitInfo(
         const point_type& min,
         const point_type& max,
         const NodeSplitDirection::Enum dir,
-        coord_type& midOut,
+        const coord_type split,
         NodeSplitDirection::Enum& newDirOut,
         point_type& newMinOut,
         point_type& newMaxOut)
@@ -277,16 +414,14 @@ private:
         switch(dir)
         {
         case NodeSplitDirection::X:
-            midOut = (min.x + max.x) / coord_type(2);
             newDirOut = NodeSplitDirection::Y;
-            newMinOut.x = midOut;
-            newMaxOut.x = midOut;
+            newMinOut.x = split;
+            newMaxOut.x = split;
             return;
         case NodeSplitDirection::Y:
-            midOut = (min.y + max.y) / coord_type(2);
             newDirOut = NodeSplitDirection::X;
-            newMinOut.y = midOut;
-            newMaxOut.y = midOut;
+            newMinOut.y = split;
+            newMaxOut.y = split;
             return;
         }
     }
@@ -313,27 +448,42 @@ private:
             point.y < m_min.y ? m_nodes[newRoot].setChildren(newLeaf, m_root)
                               : m_nodes[newRoot].setChildren(m_root, newLeaf);
             if(point.y < m_min.y)
+            {
+                m_nodes[newRoot].split = m_min.y;
                 m_min.y -= m_max.y - m_min.y;
-            else if(point.y > m_max.y)
-                m_max.y += m_max.y - m_min.y;
+            }
+            else
+            {
+                m_nodes[newRoot].split = m_max.y;
+                if(point.y > m_max.y)
+                    m_max.y += m_max.y - m_min.y;
+            }
             break;
         case NodeSplitDirection::Y:
             m_rootDir = NodeSplitDirection::X;
             point.x < m_min.x ? m_nodes[newRoot].setChildren(newLeaf, m_root)
                               : m_nodes[newRoot].setChildren(m_root, newLeaf);
             if(point.x < m_min.x)
+            {
+                m_nodes[newRoot].split = m_min.x;
                 m_min.x -= m_max.x - m_min.x;
-            else if(point.x > m_max.x)
-                m_max.x += m_max.x - m_min.x;
+            }
+            else
+            {
+                m_nodes[newRoot].split = m_max.x;
+                if(point.x > m_max.x)
+                    m_max.x += m_max.x - m_min.x;
+            }
             break;
         }
         m_root = newRoot;
     }
 
-    /// Calculate root's box enclosing all root points
-    void initializeRootBox(const std::vector<point_type>& points)
+    /// Calculate root's box enclosing given points
+    template <typename TPoints>
+    void
+    initializeRootBox(const TPoints& points, const point_data_vec& data)
     {
-        const point_data_vec& data = m_nodes[m_root].data;
         m_min = points[data.front()];
         m_max = m_min;
         for(pd_cit it = data.begin(); it != data.end(); ++it)
@@ -392,6 +542,76 @@ private:
     };
     // allocated in class (not in the 'nearest' method) for better performance
     mutable std::vector<NearestTask> m_tasksStack;
+
+    // used for bulk-loading
+    struct BulkLoadTask
+    {
+        node_index node;
+        point_data_vec::iterator first, last;
+        NodeSplitDirection::Enum dir;
+        std::size_t nFlatSplits; ///< preceding splits with an empty child
+        BulkLoadTask(
+            const node_index node,
+            const point_data_vec::iterator first,
+            const point_data_vec::iterator last,
+            const NodeSplitDirection::Enum dir,
+            const std::size_t nFlatSplits)
+            : node(node)
+            , first(first)
+            , last(last)
+            , dir(dir)
+            , nFlatSplits(nFlatSplits)
+        {}
+    };
+    /// Compares points' coordinates along split direction
+    struct CompareCoord
+    {
+        const point_type* points; ///< first point of point-buffer
+        NodeSplitDirection::Enum dir;
+        CompareCoord(
+            const point_type* points,
+            const NodeSplitDirection::Enum dir)
+            : points(points)
+            , dir(dir)
+        {}
+        coord_type coord(const point_index i) const
+        {
+            const point_type& p = points[i];
+            return dir == NodeSplitDirection::X ? p.x : p.y;
+        }
+        bool operator()(const point_index a, const point_index b) const
+        {
+            return coord(a) < coord(b);
+        }
+    };
+    /// Checks if point's coordinate is less than a given value
+    struct Less
+    {
+        CompareCoord cmp;
+        coord_type val;
+        Less(const CompareCoord& cmp, const coord_type val)
+            : cmp(cmp)
+            , val(val)
+        {}
+        bool operator()(const point_index i) const
+        {
+            return cmp.coord(i) < val;
+        }
+    };
+    /// Checks if point's coordinate is not greater than a given value
+    struct NotGreater
+    {
+        CompareCoord cmp;
+        coord_type val;
+        NotGreater(const CompareCoord& cmp, const coord_type val)
+            : cmp(cmp)
+            , val(val)
+        {}
+        bool operator()(const point_index i) const
+        {
+            return !(cmp.coord(i) > val);
+        }
+    };
 };
 
 } // namespace KDTree
@@ -0,0 +1,282 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+/**
+ * @file
+ * Near-point locator using a uniform grid of point buckets
+ */
+
+#ifndef CDT_LOCATORBUCKETGRID_H
+#define CDT_LOCATORBUCKETGRID_H
+
+#include "CDTUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace CDT
+{
+
+/**
+ * Uniform grid of point buckets
+ *
+ * Grid covers bounding box of the points without a few outliers (e.g.,
+ * super-triangle's vertices) and is re-built with a finer resolution when
+ * buckets get too full: on average a bucket holds PointsPerBucket to twice
+ * as many points. Each bucket is an intrusive singly linked list so adding
+ * a point is O(1) and needs no allocations most of the time. Query inspects
+ * rings of buckets around the query position. Good for evenly spread
+ * points; for strongly clustered points LocatorKDTree is better.
+ * @note points outside of the grid's box (outliers or added after the last
+ * re-build) are put into the border buckets: for them a near, but not
+ * necessarily the nearest, point is found
+ * @tparam TCoordType type of vertex coordinates (e.g., float, double)
+ * @tparam PointsPerBucket average number of points in a bucket
+ */
+template <typename TCoordType, std::size_t PointsPerBucket = 1>
+class LocatorBucketGrid
+{
+public:
+    /// Constructor
+    LocatorBucketGrid()
+        : m_xCellsPerUnit(0)
+        , m_yCellsPerUnit(0)
+        , m_xres(0)
+        , m_yres(0)
+        , m_size(0)
+    {}
+    /**
+     * Initialize grid with points
+     * @note chooses box and resolution of the grid, can be called again to
+     * re-build the grid from scratch when many points were added
+     */
+    template <typename TPoints>
+    void initialize(const TPoints& points)
+    {
+        m_next.assign(points.size(), noVertex);
+        std::vector<VertInd> ii(points.size());
+        for(VertInd i(0); i < VertInd(points.size()); ++i)
+            ii[i] = i;
+        build(ii, points);
+    }
+    /// Add point to its bucket, re-build the grid if buckets are too full
+    template <typename TPoints>
+    void addPoint(const VertInd i, const TPoints& points)
+    {
+        if(i >= m_next.size())
+            m_next.resize(points.size(), noVertex);
+        ++m_size;
+        if(m_size > 2 * PointsPerBucket * m_heads.size())
+        {
+            rebuild(i, points);
+            return; // point is already in the re-built grid
+        }
+        pushToBucket(i, points[i]);
+    }
+    /// Remove point from its bucket
+    template <typename TPoints>
+    void removePoint(const VertInd i, const TPoints& points)
+    {
+        if(m_heads.empty())
+            return;
+        VertInd* link = &m_heads[bucket(points[i])];
+        while(*link != noVertex && *link != i)
+            link = &m_next[*link];
+        if(*link == noVertex)
+            return;
+        *link = m_next[i];
+        m_next[i] = noVertex;
+        --m_size;
+    }
+    /// Find nearest point searching rings of buckets around the position
+    template <typename TPoints>
+    VertInd nearPoint(const V2d<TCoordType>& pos, const TPoints& points) const
+    {
+        if(m_heads.empty())
+            return VertInd(0);
+        const std::size_t cx =
+            tick(pos.x, m_box.min.x, m_xCellsPerUnit, m_xres);
+        const std::size_t cy =
+            tick(pos.y, m_box.min.y, m_yCellsPerUnit, m_yres);
+        const TCoordType minCellSize =
+            std::min(cellSize(m_xCellsPerUnit), cellSize(m_yCellsPerUnit));
+        const std::size_t maxRing = std::max(m_xres, m_yres);
+        VertInd iNearest = noVertex;
+        TCoordType minD = TCoordType(0); // squared distance to the nearest
+        for(std::size_t r = 0; r <= maxRing; ++r)
+        {
+            // points in this and further rings are at least r-1 cells away
+            if(iNearest != noVertex)
+            {
+                const TCoordType ringDist = TCoordType(r - 1) * minCellSize;
+                if(minD <= ringDist * ringDist)
+                    break;
+            }
+            const std::size_t x0 = cx >= r ? cx - r : 0;
+            const std::size_t x1 = std::min(cx + r, m_xres - 1);
+            const std::size_t y0 = cy >= r ? cy - r : 0;
+            const std::size_t y1 = std::min(cy + r, m_yres - 1);
+            for(std::size_t y = y0; y <= y1; ++y)
+            {
+                // inner rows of the ring: only left and right buckets
+                const bool isRingRow = y + r == cy || y == cy + r;
+                const std::size_t step = isRingRow || r == 0 ? 1 : 2 * r;
+                for(std::size_t x = isRingRow || cx >= r ? x0 : cx + r;
+                    x <= x1;
+                    x += step)
+                {
+                    visitBucket(y * m_xres + x, pos, points, iNearest, minD);
+                }
+            }
+        }
+        return iNearest != noVertex ? iNearest : VertInd(0);
+    }
+
+private:
+    /// Index of cell along one axis clamped to the grid
+    static std::size_t tick(
+        const TCoordType c,
+        const TCoordType min,
+        const TCoordType cellsPerUnit,
+        const std::size_t res)
+    {
+        const TCoordType t = (c - min) * cellsPerUnit;
+        return t > TCoordType(0) ? std::min(std::size_t(t), res - 1) : 0;
+    }
+    /// Cell size along an axis: infinite for a single-cell axis
+    static TCoordType cellSize(const TCoordType cellsPerUnit)
+    {
+        return cellsPerUnit > TCoordType(0)
+                   ? TCoordType(1) / cellsPerUnit
+                   : std::numeric_limits<TCoordType>::max();
+    }
+    std::size_t bucket(const V2d<TCoordType>& pos) const
+    {
+        return tick(pos.y, m_box.min.y, m_yCellsPerUnit, m_yres) * m_xres +
+               tick(pos.x, m_box.min.x, m_xCellsPerUnit, m_xres);
+    }
+    /// Update the nearest point with points in a bucket
+    template <typename TPoints>
+    void visitBucket(
+        const std::size_t b,
+        const V2d<TCoordType>& pos,
+        const TPoints& points,
+        VertInd& iNearest,
+        TCoordType& minDistSq) const
+    {
+        for(VertInd iV = m_heads[b]; iV != noVertex; iV = m_next[iV])
+        {
+            const TCoordType d = distanceSquared(pos, points[iV]);
+            if(iNearest == noVertex || d < minDistSq)
+            {
+                iNearest = iV;
+                minDistSq = d;
+            }
+        }
+    }
+    void pushToBucket(const VertInd i, const V2d<TCoordType>& pos)
+    {
+        VertInd& head = m_heads[bucket(pos)];
+        m_next[i] = head;
+        head = i;
+    }
+    /// Choose grid's box and resolution for a number of points
+    void resize(const Box2d<TCoordType>& box, const std::size_t nPoints)
+    {
+        m_box = box;
+        const std::size_t nCells =
+            std::max(nPoints / PointsPerBucket, std::size_t(1));
+        const TCoordType w = box.max.x - box.min.x;
+        const TCoordType h = box.max.y - box.min.y;
+        if(w > TCoordType(0) && h > TCoordType(0))
+        {
+            const double aspect = double(w) / double(h);
+            m_xres = std::size_t(std::sqrt(double(nCells) * aspect));
+            m_xres = std::min(std::max(m_xres, std::size_t(1)), nCells);
+            m_yres = std::max(nCells / m_xres, std::size_t(1));
+        }
+        else
+        {
+            m_xres = w > TCoordType(0) ? nCells : 1;
+            m_yres = h > TCoordType(0) ? nCells : 1;
+        }
+        m_xCellsPerUnit = w > TCoordType(0) ? TCoordType(m_xres) / w : 0;
+        m_yCellsPerUnit = h > TCoordType(0) ? TCoordType(m_yres) / h : 0;
+        m_heads.assign(m_xres * m_yres, noVertex);
+    }
+    /// Re-build the grid from the points in the buckets and a new point
+    template <typename TPoints>
+    void rebuild(const VertInd iNew, const TPoints& points)
+    {
+        std::vector<VertInd> ii;
+        ii.reserve(m_size);
+        for(std::size_t b = 0; b < m_heads.size(); ++b)
+            for(VertInd iV = m_heads[b]; iV != noVertex; iV = m_next[iV])
+                ii.push_back(iV);
+        ii.push_back(iNew);
+        build(ii, points);
+    }
+    /// Build the grid with given points
+    template <typename TPoints>
+    void build(const std::vector<VertInd>& ii, const TPoints& points)
+    {
+        m_size = ii.size();
+        resize(trimmedBox(ii, points), ii.size());
+        typedef std::vector<VertInd>::const_iterator Cit;
+        for(Cit it = ii.begin(); it != ii.end(); ++it)
+            pushToBucket(*it, points[*it]);
+    }
+    /**
+     * Bounding box of points without a few outliers on each side, e.g.,
+     * super-triangle's vertices: otherwise most buckets would be empty
+     */
+    template <typename TPoints>
+    static Box2d<TCoordType> trimmedBox(
+        const std::vector<VertInd>& ii,
+        const TPoints& points)
+    {
+        const TCoordType max = std::numeric_limits<TCoordType>::max();
+        Box2d<TCoordType> box = {{max, max}, {-max, -max}};
+        const std::size_t nTrim = ii.size() / 64;
+        if(nTrim == 0)
+        {
+            typedef std::vector<VertInd>::const_iterator Cit;
+            for(Cit it = ii.begin(); it != ii.end(); ++it)
+                box.envelopPoint(points[*it]);
+            return box;
+        }
+        std::vector<TCoordType> cc(ii.size());
+        const typename std::vector<TCoordType>::iterator first = cc.begin(),
+                                                         last = cc.end();
+        for(std::size_t i = 0; i < ii.size(); ++i)
+            cc[i] = points[ii[i]].x;
+        std::nth_element(first, first + nTrim, last);
+        box.min.x = cc[nTrim];
+        std::nth_element(first, last - 1 - nTrim, last);
+        box.max.x = *(last - 1 - nTrim);
+        for(std::size_t i = 0; i < ii.size(); ++i)
+            cc[i] = points[ii[i]].y;
+        std::nth_element(first, first + nTrim, last);
+        box.min.y = cc[nTrim];
+        std::nth_element(first, last - 1 - nTrim, last);
+        box.max.y = *(last - 1 - nTrim);
+        return box;
+    }
+
+    Box2d<TCoordType> m_box;
+    TCoordType m_xCellsPerUnit;
+    TCoordType m_yCellsPerUnit;
+    std::size_t m_xres;
+    std::size_t m_yres;
+    std::vector<VertInd> m_heads; ///< first point in each bucket
+    std::vector<VertInd> m_next;  ///< next point in the same bucket
+    std::size_t m_size;           ///< number of points in the buckets
+};
+
+} // namespace CDT
+
+#endif
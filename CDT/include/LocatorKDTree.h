@@ -25,33 +25,31 @@ template <
 class LocatorKDTree
 {
 public:
-    /// Initialize KD-tree with points
-    void initialize(const std::vector<V2d<TCoordType> >& points)
+    /**
+     * Initialize KD-tree with points
+     * @note builds a balanced tree at once (bulk-load), can be called again to
+     * re-build the tree from scratch when many points were added
+     */
+    template <typename TPoints>
+    void initialize(const TPoints& points)
     {
-        typedef V2d<TCoordType> V2d_t;
-        V2d_t min = points.front();
-        V2d_t max = min;
-        typedef typename std::vector<V2d_t>::const_iterator Cit;
-        for(Cit it = points.begin(); it != points.end(); ++it)
-        {
-            min = V2d_t::make(std::min(min.x, it->x), std::min(min.y, it->y));
-            max = V2d_t::make(std::max(max.x, it->x), std::max(max.y, it->y));
-        }
-        m_kdTree = KDTree_t(min, max);
-        for(VertInd i = 0; i < points.size(); ++i)
-        {
-            m_kdTree.insert(i, points);
-        }
+        m_kdTree.bulkLoad(points);
     }
     /// Add point to KD-tree
-    void addPoint(const VertInd i, const std::vector<V2d<TCoordType> >& points)
+    template <typename TPoints>
+    void addPoint(const VertInd i, const TPoints& points)
     {
         m_kdTree.insert(i, points);
     }
+    /// Remove point from KD-tree
+    template <typename TPoints>
+    void removePoint(const VertInd i, const TPoints& points)
+    {
+        m_kdTree.remove(i, points);
+    }
     /// Find nearest point using R-tree
-    VertInd nearPoint(
-        const V2d<TCoordType>& pos,
-        const std::vector<V2d<TCoordType> >& points) const
+    template <typename TPoints>
+    VertInd nearPoint(const V2d<TCoordType>& pos, const TPoints& points) const
     {
         return m_kdTree.nearest(pos, points).second;
     }
@@ -0,0 +1,74 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+/**
+ * @file
+ * Near-point locator returning the last inserted point
+ */
+
+#ifndef CDT_LOCATORLASTINSERTED_H
+#define CDT_LOCATORLASTINSERTED_H
+
+#include "CDTUtils.h"
+
+#include <vector>
+
+namespace CDT
+{
+
+/**
+ * Locator that returns the most recently inserted point
+ *
+ * Keeps no search structure at all: initializing and adding points is O(1)
+ * and takes no memory. Walk to a new point starts from the previous point,
+ * so it is short only when consecutive points are close, e.g., with
+ * spatially sorted input inserted in VertexInsertionOrder::AsProvided.
+ * @note VertexInsertionOrder::BRIO already walks from the previous point
+ * inside of each batch: the locator is asked only for the batch's first
+ * point
+ * @tparam TCoordType type of vertex coordinates (e.g., float, double)
+ */
+template <typename TCoordType>
+class LocatorLastInserted
+{
+public:
+    /// Constructor
+    LocatorLastInserted()
+        : m_last(0)
+    {}
+    /// Start from the last of the points
+    template <typename TPoints>
+    void initialize(const TPoints& points)
+    {
+        m_last = points.empty() ? VertInd(0) : VertInd(points.size() - 1);
+    }
+    /// Remember added point
+    template <typename TPoints>
+    void addPoint(const VertInd i, const TPoints&)
+    {
+        m_last = i;
+    }
+    /// Forget removed point: fall back to the first point
+    template <typename TPoints>
+    void removePoint(const VertInd i, const TPoints&)
+    {
+        if(m_last == i)
+            m_last = VertInd(0);
+    }
+    /// Last inserted point
+    template <typename TPoints>
+    VertInd nearPoint(
+        const V2d<TCoordType>& /*pos*/,
+        const TPoints& /*points*/) const
+    {
+        return m_last;
+    }
+
+private:
+    VertInd m_last; ///< most recently inserted point
+};
+
+} // namespace CDT
+
+#endif
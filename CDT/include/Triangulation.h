@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iterator>
+#include <memory>
 #include <stack>
 #include <stdexcept>
 #include <utility>
@@ -44,6 +45,13 @@ struct CDT_EXPORT VertexInsertionOrder
     {
         Randomized, ///< vertices will be inserted in random order
         AsProvided, ///< vertices will be inserted in the same order as provided
+        /**
+         * Biased randomized insertion order: vertices are shuffled and split
+         * into rounds of doubling size, within each round vertices are sorted
+         * along a Hilbert curve. Walk for each vertex starts from previously
+         * inserted vertex instead of querying the near-point locator.
+         */
+        BRIO,
     };
 };
 
@@ -61,6 +69,37 @@ struct CDT_EXPORT SuperGeometryType
     };
 };
 
+/**
+ * Enum of orders of vertices and triangles for better memory locality
+ */
+struct CDT_EXPORT ReorderingStrategy
+{
+    /**
+     * The Enum itself
+     * @note needed to pre c++11 compilers that don't support 'class enum'
+     */
+    enum Enum
+    {
+        Hilbert, ///< vertices are sorted along a Hilbert curve
+        /**
+         * Vertices are ordered by reverse Cuthill-McKee algorithm: minimizes
+         * bandwidth of the vertex adjacency matrix (e.g., FEM matrices)
+         */
+        ReverseCuthillMcKee,
+    };
+};
+
+/**
+ * Permutations of vertices and triangles applied by re-ordering
+ * @details New i-th element is the old element with index stored at i:
+ * attributes are re-mapped as newAttributes[i] = attributes[vertices[i]]
+ */
+struct CDT_EXPORT Reordering
+{
+    std::vector<VertInd> vertices; ///< old vertex index by new vertex index
+    std::vector<TriInd> triangles; ///< old triangle index by new index
+};
+
 /**
  * Enum of strategies for treating intersecting constraint edges
  */
@@ -85,9 +124,53 @@ struct CDT_EXPORT IntersectingConstraintEdges
 typedef unsigned short LayerDepth;
 typedef LayerDepth BoundaryOverlapCount;
 
+/**
+ * Scratch buffers of traversing triangles layer by layer
+ * @details Keeping a workspace between calls of
+ * Triangulation::calculateTriangleDepths avoids heap allocations
+ */
+struct CDT_EXPORT TraversalWorkspace
+{
+    std::vector<TriInd> stack; ///< triangles to visit in the current layer
+    /// seeds of deeper layers: binary min-heap of (depth, triangle)
+    std::vector<std::pair<LayerDepth, TriInd> > deeperSeeds;
+};
+
 /// Triangles by vertex index
 typedef std::vector<TriIndVec> VerticesTriangles;
 
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+/**
+ * Single adjacent triangle by vertex index
+ * @note all triangles adjacent to a vertex are found by walking around the
+ * vertex using triangles' neighbors
+ */
+typedef std::vector<TriInd> VerticesAdjacency;
+#else
+/// All adjacent triangles by vertex index
+typedef VerticesTriangles VerticesAdjacency;
+#endif
+
+namespace detail
+{
+
+/// Allocator of elements of type U of the same kind as a given allocator
+template <typename TAllocator, typename U>
+struct RebindAllocator
+{
+#ifdef CDT_CXX11_IS_SUPPORTED
+    /// Rebound allocator type
+    typedef typename std::allocator_traits<
+        TAllocator>::template rebind_alloc<U>
+        type;
+#else
+    /// Rebound allocator type
+    typedef typename TAllocator::template rebind<U>::other type;
+#endif
+};
+
+} // namespace detail
+
 /**
  * @defgroup Triangulation Triangulation Class
  * Class performing triangulations.
@@ -99,24 +182,97 @@ typedef std::vector<TriIndVec> VerticesTriangles;
  *
  * @tparam T type of vertex coordinates (e.g., float, double)
  * @tparam TNearPointLocator class providing locating near point for efficiently
- * inserting new points. Provides methods: 'addPoint(vPos, iV)' and
- * 'nearPoint(vPos) -> iV'
+ * inserting new points. Provides methods:
+ *  - 'initialize(points)': (re-)build from all the points, called with
+ *    super-geometry and after inserting large batches of vertices
+ *  - 'addPoint(iV, points)': called after each inserted vertex
+ *  - 'removePoint(iV, points)': called by Triangulation::removeVertex
+ *  - 'nearPoint(pos, points) const -> iV': vertex to start the walk to a new
+ *    point from; any vertex is correct, a closer one makes the walk shorter
+ *
+ * 'points' are triangulation's vertices of type Triangulation::V2dVec.
+ * Shipped locators: LocatorKDTree (default, robust for any distribution),
+ * LocatorBucketGrid (cheaper updates for evenly spread points) and
+ * LocatorLastInserted (no structure, for spatially sorted input). They
+ * accept vertices with any allocator but keep their own data on the heap.
+ * @tparam TAllocator allocator of triangulation's public containers (rebound
+ * to each element type). Allocators are default-constructed, e.g., a
+ * stateless allocator drawing from a thread-local arena. With the default
+ * std::allocator the containers have the same types as CDT::TriangleVec,
+ * CDT::EdgeUSet, etc.
  */
-template <typename T, typename TNearPointLocator = LocatorKDTree<T> >
+template <
+    typename T,
+    typename TNearPointLocator = LocatorKDTree<T>,
+    typename TAllocator = std::allocator<T> >
 class CDT_EXPORT Triangulation
 {
 public:
-    typedef std::vector<V2d<T> > V2dVec; ///< Vertices vector
-    V2dVec vertices;                     ///< triangulation's vertices
-    TriangleVec triangles;               ///< triangulation's triangles
-    EdgeUSet fixedEdges; ///< triangulation's constraints (fixed edges)
+    /// Vertices vector
+    typedef std::vector<
+        V2d<T>,
+        typename detail::RebindAllocator<TAllocator, V2d<T> >::type>
+        V2dVec;
+    /// Triangles vector
+    typedef std::vector<
+        Triangle,
+        typename detail::RebindAllocator<TAllocator, Triangle>::type>
+        Triangles;
+    /// Hash table of fixed edges
+    typedef unordered_set<
+        Edge,
+        EdgeUSet::hasher,
+        EdgeUSet::key_equal,
+        typename detail::RebindAllocator<TAllocator, Edge>::type>
+        FixedEdges;
+    /// Triangles adjacent to a vertex
+    typedef std::vector<
+        TriInd,
+        typename detail::RebindAllocator<TAllocator, TriInd>::type>
+        AdjacentTriangles;
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    /// Single adjacent triangle by vertex index
+    typedef AdjacentTriangles Adjacency;
+#else
+    /// All adjacent triangles by vertex index
+    typedef std::vector<
+        AdjacentTriangles,
+        typename detail::RebindAllocator<TAllocator, AdjacentTriangles>::type>
+        Adjacency;
+#endif
+    /// Overlap counts by fixed edge
+    typedef unordered_map<
+        Edge,
+        BoundaryOverlapCount,
+        EdgeUSet::hasher,
+        EdgeUSet::key_equal,
+        typename detail::RebindAllocator<
+            TAllocator,
+            std::pair<const Edge, BoundaryOverlapCount> >::type>
+        OverlapCounts;
+    /// Original edges by fixed edge
+    typedef unordered_map<
+        Edge,
+        EdgeVec,
+        EdgeUSet::hasher,
+        EdgeUSet::key_equal,
+        typename detail::RebindAllocator<
+            TAllocator,
+            std::pair<const Edge, EdgeVec> >::type>
+        PieceToOriginals;
+
+    V2dVec vertices;       ///< triangulation's vertices
+    Triangles triangles;   ///< triangulation's triangles
+    FixedEdges fixedEdges; ///< triangulation's constraints (fixed edges)
     /**
      * triangles adjacent to each vertex
      * @note will be reset to empty when super-triangle is removed and
      * triangulation is finalized. To re-calculate adjacent triangles use
      * CDT::calculateTrianglesByVertex helper
+     * @note if CDT_USE_COMPACT_VERTEX_ADJACENCY is defined only one adjacent
+     * triangle is stored for each vertex
      */
-    VerticesTriangles vertTris;
+    Adjacency vertTris;
 
     /** Stores count of overlapping boundaries for a fixed edge. If no entry is
      * present for an edge: no boundaries overlap.
@@ -125,14 +281,21 @@ public:
      * @note needed for handling depth calculations and hole-removel in case of
      * overlapping boundaries
      */
-    unordered_map<Edge, BoundaryOverlapCount> overlapCount;
+    OverlapCounts overlapCount;
 
     /** Stores list of original edges represented by a given fixed edge
      * @note map only has entries for edges where multiple original fixed edges
      * overlap or where a fixed edge is a part of original edge created by
      * conforming Delaunay triangulation vertex insertion
      */
-    unordered_map<Edge, EdgeVec> pieceToOriginals;
+    PieceToOriginals pieceToOriginals;
+#ifdef CDT_ENABLE_STATS
+    /** Counters of events on the hot paths collected by inserting vertices
+     * and edges. Reset by assigning default-constructed stats.
+     * @note only available if CDT_ENABLE_STATS is defined
+     */
+    TriangulationStats stats;
+#endif
 
     /*____ API _____*/
     /// Default constructor
@@ -173,6 +336,9 @@ public:
         T minDistToConstraintEdge);
     /**
      * Insert custom point-types specified by iterator range and X/Y-getters
+     * @details Coordinates stored in separate buffers (e.g., table columns)
+     * can be inserted without copying them into points first: iterate over
+     * x-buffer and let Y-getter read y-buffer at the same offset.
      * @tparam TVertexIter iterator that dereferences to custom point type
      * @tparam TGetVertexCoordX function object getting x coordinate from
      * vertex. Getter signature: const TVertexIter::value_type& -> T
@@ -197,6 +363,47 @@ public:
      * @param vertices vector of vertices to insert
      */
     void insertVertices(const std::vector<V2d<T> >& vertices);
+    /**
+     * Insert custom point-types into an empty triangulation using multiple
+     * threads. Vertices are split into vertical strips by x-coordinate,
+     * strips are triangulated concurrently and merged into a single
+     * triangulation by re-inserting the vertices of the seams between the
+     * strips.
+     * @note Falls back to Triangulation::insertVertices if triangulation is
+     * not empty, if there are too few vertices, or if merging the strips
+     * fails. Without C++11 support strips are triangulated sequentially.
+     * @note Constraints can be added with Triangulation::insertEdges after
+     * vertices are inserted
+     * @tparam TVertexIter iterator that dereferences to custom point type
+     * @tparam TGetVertexCoordX function object getting x coordinate from
+     * vertex. Getter signature: const TVertexIter::value_type& -> T
+     * @tparam TGetVertexCoordY function object getting y coordinate from
+     * vertex. Getter signature: const TVertexIter::value_type& -> T
+     * @param first beginning of the range of vertices to add
+     * @param last end of the range of vertices to add
+     * @param getX getter of X-coordinate
+     * @param getY getter of Y-coordinate
+     * @param nThreads number of threads (and strips) to use
+     */
+    template <
+        typename TVertexIter,
+        typename TGetVertexCoordX,
+        typename TGetVertexCoordY>
+    void insertVerticesParallel(
+        TVertexIter first,
+        TVertexIter last,
+        TGetVertexCoordX getX,
+        TGetVertexCoordY getY,
+        std::size_t nThreads);
+    /**
+     * Insert vertices into an empty triangulation using multiple threads
+     * @param vertices vector of vertices to insert
+     * @param nThreads number of threads (and strips) to use
+     * @sa Triangulation::insertVerticesParallel
+     */
+    void insertVerticesParallel(
+        const std::vector<V2d<T> >& vertices,
+        std::size_t nThreads);
     /**
      * Insert constraints (custom-type fixed edges) into triangulation
      * @note Each fixed edge is inserted by deleting the triangles it crosses,
@@ -279,6 +486,145 @@ public:
      * @tparam edges edges to conform to
      */
     void conformToEdges(const std::vector<Edge>& edges);
+    /**
+     * Insert constraints (custom-type fixed edges) into triangulation in
+     * spatial order
+     * @details Edges are sorted along a Hilbert curve by their mid-points
+     * before inserting: consecutive insertions modify nearby triangles which
+     * keeps the working set small. Useful for large numbers of short edges,
+     * e.g., networks of polylines.
+     * @note Result is same as of Triangulation::insertEdges, except for
+     * degenerate cases where the constrained Delaunay triangulation is not
+     * unique (e.g., co-circular points), and for the order of vertices added
+     * when resolving intersecting edges.
+     * @tparam TEdgeIter iterator that dereferences to custom edge type
+     * @tparam TGetEdgeVertexStart function object getting start vertex index
+     * from an edge.
+     * Getter signature: const TEdgeIter::value_type& -> CDT::VertInd
+     * @tparam TGetEdgeVertexEnd function object getting end vertex index from
+     * an edge. Getter signature: const TEdgeIter::value_type& -> CDT::VertInd
+     * @param first beginning of the range of edges to add
+     * @param last end of the range of edges to add
+     * @param getStart getter of edge start vertex index
+     * @param getEnd getter of edge end vertex index
+     * @sa Triangulation::insertEdges
+     */
+    template <
+        typename TEdgeIter,
+        typename TGetEdgeVertexStart,
+        typename TGetEdgeVertexEnd>
+    void insertEdgesBatch(
+        TEdgeIter first,
+        TEdgeIter last,
+        TGetEdgeVertexStart getStart,
+        TGetEdgeVertexEnd getEnd);
+    /**
+     * Insert constraint edges into triangulation in spatial order
+     * @param edges constraint edges
+     * @sa Triangulation::insertEdgesBatch
+     */
+    void insertEdgesBatch(const std::vector<Edge>& edges);
+    /**
+     * Ensure that triangulation conforms to constraints (fixed edges),
+     * process constraints in spatial order
+     * @details Edges are sorted along a Hilbert curve by their mid-points
+     * before conforming to them.
+     * @note Result is same as of Triangulation::conformToEdges, except for
+     * degenerate cases and for the order of added vertices.
+     * @tparam TEdgeIter iterator that dereferences to custom edge type
+     * @tparam TGetEdgeVertexStart function object getting start vertex index
+     * from an edge.
+     * Getter signature: const TEdgeIter::value_type& -> CDT::VertInd
+     * @tparam TGetEdgeVertexEnd function object getting end vertex index from
+     * an edge. Getter signature: const TEdgeIter::value_type& -> CDT::VertInd
+     * @param first beginning of the range of edges to add
+     * @param last end of the range of edges to add
+     * @param getStart getter of edge start vertex index
+     * @param getEnd getter of edge end vertex index
+     * @sa Triangulation::conformToEdges
+     */
+    template <
+        typename TEdgeIter,
+        typename TGetEdgeVertexStart,
+        typename TGetEdgeVertexEnd>
+    void conformToEdgesBatch(
+        TEdgeIter first,
+        TEdgeIter last,
+        TGetEdgeVertexStart getStart,
+        TGetEdgeVertexEnd getEnd);
+    /**
+     * Ensure that triangulation conforms to constraints (fixed edges),
+     * process constraints in spatial order
+     * @param edges edges to conform to
+     * @sa Triangulation::conformToEdgesBatch
+     */
+    void conformToEdgesBatch(const std::vector<Edge>& edges);
+    /**
+     * Limit the number of edge mid-points (Steiner points) that can be
+     * added by one call to conformToEdges or conformToEdgesBatch
+     * @details Conforming to constraints that nearly touch each other can
+     * add very many mid-points. When the limit is reached conforming throws
+     * std::runtime_error: the triangulation's topology stays valid but not
+     * all of the edges are conformed to. The edge being conformed to is
+     * left partly fixed: only some of its pieces are in
+     * Triangulation::fixedEdges. Fixed edges that were flipped while adding
+     * its mid-points and were waiting to be re-inserted are not fixed
+     * anymore. By default the number is not limited.
+     * @param maxSteinerPoints maximal number of mid-points added per call
+     */
+    void setMaxSteinerPoints(std::size_t maxSteinerPoints);
+    /// Maximal number of mid-points added by one call to conformToEdges
+    std::size_t maxSteinerPoints() const;
+    /**
+     * Insert a polyline (chain of constraint edges) into triangulation
+     * @details Consecutive edges of a polyline share a vertex: insertion of
+     * an edge continues from the triangle where insertion of the previous
+     * edge has ended instead of searching all triangles around the vertex.
+     * @note Result is same as of inserting polyline's edges with
+     * Triangulation::insertEdges, except for degenerate cases where the
+     * constrained Delaunay triangulation is not unique (e.g., co-circular
+     * points), and for the order of vertices added when resolving
+     * intersecting edges.
+     * @tparam TVertIndIter forward iterator that dereferences to vertex index
+     * @param first beginning of the range of polyline's vertex indices
+     * @param last end of the range of polyline's vertex indices
+     * @param isClosed if true last vertex of the polyline is connected to the
+     * first one (unless polyline has less than 3 vertices)
+     */
+    template <typename TVertIndIter>
+    void insertPolyline(TVertIndIter first, TVertIndIter last, bool isClosed);
+    /**
+     * Insert open polylines (chains of constraint edges) into triangulation
+     * @param polylines vertex indices of each polyline
+     * @sa Triangulation::insertPolyline
+     */
+    void insertPolylines(const std::vector<std::vector<VertInd> >& polylines);
+    /**
+     * Insert closed polylines (rings of constraint edges) into triangulation
+     * @param rings vertex indices of each ring, first vertex is not repeated
+     * @sa Triangulation::insertPolyline
+     */
+    void insertRings(const std::vector<std::vector<VertInd> >& rings);
+    /**
+     * Remove a vertex from triangulation
+     * @details Triangles around the vertex are replaced with a constrained
+     * Delaunay triangulation of the resulting cavity: cost is proportional to
+     * the number of vertex's neighbors. Constraint edges ending at the
+     * vertex are removed together with the vertex. If the vertex splits a
+     * constraint edge in two (it has exactly two constraint edges that are
+     * pieces of the same original edge or lie on one line), the pieces are
+     * merged back into a single constraint edge.
+     * @throws std::runtime_error if the vertex splits more than one
+     * constraint edge, e.g., it was added at an intersection of two
+     * constraint edges
+     * @note Vertex is kept in Triangulation::vertices to keep indices of other
+     * vertices valid, it is not used by any triangle after removal. Removing
+     * vertices requires near-point locator to provide 'removePoint(iV,
+     * points)' method.
+     * @param iVertex index of the vertex to remove. Same indexing as for
+     * inserting edges: super-triangle vertices are not counted.
+     */
+    void removeVertex(VertInd iVertex);
     /**
      * Erase triangles adjacent to super triangle
      *
@@ -294,11 +640,77 @@ public:
      * @note supports overlapping or touching boundaries
      */
     void eraseOuterTrianglesAndHoles();
+    /**
+     * Erase triangles outside of constrained boundary and auto-detected holes
+     * using multiple threads to find triangle depths
+     * @param nThreads number of threads to use
+     * @sa Triangulation::eraseOuterTrianglesAndHoles,
+     * Triangulation::calculateTriangleDepthsParallel
+     */
+    void eraseOuterTrianglesAndHolesParallel(std::size_t nThreads);
+    /**
+     * Make a finalized copy with triangles adjacent to super triangle erased
+     * @details Unlike Triangulation::eraseSuperTriangle this triangulation is
+     * not modified: more vertices and edges can be inserted into it later and
+     * an updated copy can be made again.
+     * @note Mirrors Triangulation::eraseSuperTriangle: when custom
+     * super-geometry is used nothing is erased and an unchanged (not
+     * finalized) copy is returned
+     * @return finalized triangulation with vertex indices re-mapped the same
+     * way as by Triangulation::eraseSuperTriangle
+     */
+    Triangulation withSuperTriangleErased() const;
+    /**
+     * Make a finalized copy with triangles outside of constrained boundary
+     * erased. Triangulation is not modified.
+     * @sa Triangulation::eraseOuterTriangles,
+     * Triangulation::withSuperTriangleErased
+     */
+    Triangulation withOuterTrianglesErased() const;
+    /**
+     * Make a finalized copy with triangles outside of constrained boundary
+     * and in auto-detected holes erased. Triangulation is not modified.
+     * @sa Triangulation::eraseOuterTrianglesAndHoles,
+     * Triangulation::withSuperTriangleErased
+     */
+    Triangulation withOuterTrianglesAndHolesErased() const;
+    /**
+     * Re-order vertices and triangles of a finalized triangulation for better
+     * memory locality, e.g., before uploading to GPU or assembling FEM
+     * matrices
+     * @details Triangles are sorted by their smallest new vertex index.
+     * Neighbors, fixed edges, overlap counts and edge pieces are re-mapped.
+     * Super-geometry vertices kept in the triangulation are not moved.
+     * @param strategy order of vertices
+     * @return applied permutations for re-mapping callers' attributes
+     */
+    Reordering reorder(ReorderingStrategy::Enum strategy);
     /**
      * Call this method after directly setting custom super-geometry via
      * vertices and triangles members
      */
     void initializedWithCustomSuperGeometry();
+    /**
+     * Call this method after directly setting state of a triangulation that
+     * is not finalized (e.g., loaded from a file): vertices, triangles,
+     * vertTris and constraint edges. Restores the rest of internal state.
+     * @param superGeomType type of super-geometry the triangulation uses
+     * @param nSuperGeomVerts number of super-geometry vertices at the
+     * beginning of Triangulation::vertices
+     */
+    void initializedWithSuperGeometry(
+        SuperGeometryType::Enum superGeomType,
+        std::size_t nSuperGeomVerts);
+    /**
+     * Create super-triangle enclosing a given box before inserting vertices
+     * @details By default super-triangle is fitted to the first inserted
+     * batch of vertices and vertices inserted later must be inside of it.
+     * Use this method when vertices arrive in batches (e.g., tiles) and their
+     * total extent is known in advance.
+     * @note can only be called on an empty triangulation
+     * @param box box enclosing all the vertices that will be inserted
+     */
+    void initializeSuperTriangle(const Box2d<T>& box);
 
     /**
      * Check if the triangulation was finalized with `erase...` method and
@@ -306,6 +718,27 @@ public:
      * @return true if triangulation is finalized, false otherwise
      */
     bool isFinalized() const;
+    /// Type of super-geometry used by the triangulation
+    SuperGeometryType::Enum superGeometryType() const;
+    /**
+     * Number of super-geometry vertices at the beginning of
+     * Triangulation::vertices. Vertex indices of inserted edges don't count
+     * them.
+     */
+    std::size_t superGeometryVertexCount() const;
+
+    /**
+     * Clear triangulation so that the instance can be re-used for another
+     * triangulation, e.g., of the next tile.
+     * @details Triangulation options given at construction are kept.
+     * Capacity of the vectors is kept: vertices, triangles, per-vertex
+     * triangle lists and scratch buffers don't allocate again when
+     * similarly sized inputs are triangulated with the same instance.
+     * @note hash containers (fixed edges, overlap counts, pieces of
+     * original edges) free their nodes when cleared and the near-point
+     * locator is re-built from scratch: these still allocate
+     */
+    void reset();
 
     /**
      * Calculate depth of each triangle in constraint triangulation. Supports
@@ -321,6 +754,70 @@ public:
      * @return vector where element at index i stores depth of i-th triangle
      */
     std::vector<LayerDepth> calculateTriangleDepths() const;
+    /**
+     * Calculate depth of each triangle re-using buffers: repeated calls do
+     * not allocate once the buffers are large enough
+     * @param[out] triDepths element at index i stores depth of i-th triangle
+     * @param workspace scratch buffers kept between calls
+     */
+    void calculateTriangleDepths(
+        std::vector<LayerDepth>& triDepths,
+        TraversalWorkspace& workspace) const;
+    /**
+     * Calculate depth of each triangle using multiple threads
+     * @details Gives the same depths as
+     * Triangulation::calculateTriangleDepths but instead of peeling layers
+     * one by one finds connected regions: triangles are split into chunks,
+     * each thread joins triangles of its chunk sharing non-constraint edges
+     * (union-find) and collects constraint edges between regions. Regions
+     * are then joined across chunks and their depths are found by a
+     * shortest-path search over the graph of regions: crossing a constraint
+     * edge adds its boundary overlap count plus one.
+     * @param nThreads number of threads to use
+     * @return vector where element at index i stores depth of i-th triangle
+     */
+    std::vector<LayerDepth>
+    calculateTriangleDepthsParallel(std::size_t nThreads) const;
+
+    /**
+     * Find triangle containing a point
+     * @details Walks from the hint triangle towards the point. Without a
+     * hint the walk starts from the closest of a small sample of triangles.
+     * Falls back to checking all triangles when the walk is blocked by the
+     * boundary of a triangulation that is not known to be convex, e.g., for
+     * points in holes, or when the walk doesn't finish within its step
+     * limit. Convexity is found when the boundary is set up: by
+     * super-triangle, Triangulation::initializedWithCustomSuperGeometry or
+     * when finalizing.
+     * @note Thread-safe: doesn't modify any state, can be called
+     * concurrently on a triangulation that is not being modified.
+     * @param pos point to locate
+     * @param hint triangle to start the walk from, e.g., triangle of a
+     * previously located nearby point. noNeighbor if unknown.
+     * @return triangle containing the point and the point's location on it.
+     * Location is PtTriLocation::Outside and triangle is noNeighbor when no
+     * triangle contains the point.
+     */
+    TriangleLocation locate(const V2d<T>& pos, TriInd hint = noNeighbor) const;
+    /**
+     * Find triangle containing a point starting from a previous result
+     * @sa Triangulation::locate
+     */
+    TriangleLocation
+    locate(const V2d<T>& pos, const TriangleLocation& hint) const;
+    /**
+     * Find triangles containing many points
+     * @details Points are sorted along a Hilbert curve so that each walk
+     * starts from the triangle of the previous nearby point. Sorted points
+     * are split into equal chunks processed by separate threads.
+     * @param positions points to locate
+     * @param nThreads number of threads to use
+     * @return locations of points in the same order as the points
+     * @sa Triangulation::locate
+     */
+    std::vector<TriangleLocation> locateMany(
+        const std::vector<V2d<T> >& positions,
+        std::size_t nThreads = 1) const;
 
     /**
      * @defgroup Advanced Advanced Triangulation Methods
@@ -345,19 +842,64 @@ public:
      * @param removedTriangles indices of triangles to remove
      */
     void removeTriangles(const TriIndUSet& removedTriangles);
+    /**
+     * Remove triangles flagged in a bitmask.
+     * Adjust internal triangulation state accordingly.
+     * @note takes linear time: triangles are compacted and their neighbors
+     * are re-mapped in a single pass without hashing
+     * @param removedTriangles flag for each triangle: true if triangle should
+     * be removed
+     */
+    void removeTriangles(const std::vector<bool>& removedTriangles);
     /// @}
 
 private:
     /*____ Detail __*/
     void addSuperTriangle(const Box2d<T>& box);
-    void addNewVertex(const V2d<T>& pos, const TriIndVec& tris);
+    void addNewVertex(const V2d<T>& pos, const AdjacentTriangles& tris);
     void insertVertex(VertInd iVert);
+    /// Insert vertex starting triangle walk from a given vertex
+    void insertVertex(VertInd iVert, VertInd walkStart);
+    /**
+     * Insert vertices with indices starting from a given one in biased
+     * randomized order (BRIO)
+     * @param iFirst index of the first vertex to insert
+     */
+    void insertVertices_BRIO(VertInd iFirst);
+    /**
+     * Insert vertices with indices starting from a given one using
+     * triangulation's vertex insertion order
+     * @param iFirst index of the first vertex to insert
+     */
+    void insertVertices_Ordered(VertInd iFirst);
+    /**
+     * Insert all added vertices by triangulating vertical strips in parallel
+     * and re-inserting vertices of the seams between the strips
+     * @param nThreads number of threads (and strips) to use
+     */
+    void insertVertices_Parallel(std::size_t nThreads);
+    /// Triangulate vertices of a strip: executed by parallel insertion
+    void triangulateStrip(const std::vector<V2d<T> >& stripVertices);
+    /// Reset to super-triangle and insert added vertices one-by-one
+    void insertVertices_SerialFallback();
     void ensureDelaunayByEdgeFlips(
         const V2d<T>& v,
         VertInd iVert,
         std::stack<TriInd>& triStack);
     /// Flip fixed edges and return a list of flipped fixed edges
     std::vector<Edge> insertVertex_FlipFixedEdges(VertInd iVert);
+    /// Same as above for a vertex in already known triangle(s)
+    std::vector<Edge> insertVertex_FlipFixedEdges(
+        VertInd iVert,
+        const array<TriInd, 2>& trisAt);
+    /**
+     * Find triangle(s) containing a point among a few candidate triangles
+     * @return same as Triangulation::trianglesAt, no-neighbor if none of the
+     * candidates contains the point
+     */
+    array<TriInd, 2> candidateTrianglesAt(
+        const V2d<T>& pos,
+        const std::vector<TriInd>& candidates) const;
 
     typedef std::vector<VertInd>::const_iterator VertIndCit;
     /// State for an iteration of triangulate pseudo-polygon
@@ -372,6 +914,10 @@ private:
      * be inserted
      * @param[in,out] tppIterations stack to be used for storing iterations of
      * triangulating pseudo-polygon
+     * @param[in,out] iThint triangle adjacent to one of the edge's vertices
+     * or no-neighbor. Edge insertion starts from the vertex the hint triangle
+     * is adjacent to. Returns triangle adjacent to the end vertex of the last
+     * inserted edge part or no-neighbor.
      * @note in-out state (@param remaining @param tppIterations) is shared
      * between different runs for performance gains (reducing memory
      * allocations)
@@ -380,7 +926,8 @@ private:
         Edge edge,
         Edge originalEdge,
         EdgeVec& remaining,
-        std::vector<TriangulatePseudopolygonTask>& tppIterations);
+        std::vector<TriangulatePseudopolygonTask>& tppIterations,
+        TriInd& iThint);
 
     /**
      * Insert an edge or its part into constraint Delaunay triangulation
@@ -390,6 +937,7 @@ private:
      * be inserted
      * @param[in,out] tppIterations stack to be used for storing iterations of
      * triangulating pseudo-polygon
+     * @param[in,out] iThint triangle adjacent to the edge part's start
      * @note in-out state (@param remaining @param tppIterations) is shared
      * between different runs for performance gains (reducing memory
      * allocations)
@@ -398,11 +946,33 @@ private:
         Edge edge,
         Edge originalEdge,
         EdgeVec& remaining,
-        std::vector<TriangulatePseudopolygonTask>& tppIterations);
+        std::vector<TriangulatePseudopolygonTask>& tppIterations,
+        TriInd& iThint);
 
     /// State for iteration of conforming to edge
     typedef tuple<Edge, EdgeVec, BoundaryOverlapCount> ConformToEdgeTask;
 
+    /**
+     * Collect edges with indices accounting for super-geometry vertices
+     * @param[out] edges collected edges
+     */
+    template <
+        typename TEdgeIter,
+        typename TGetEdgeVertexStart,
+        typename TGetEdgeVertexEnd>
+    void collectEdges(
+        TEdgeIter first,
+        TEdgeIter last,
+        TGetEdgeVertexStart getStart,
+        TGetEdgeVertexEnd getEnd,
+        EdgeVec& edges) const;
+    /// Sort edges along a Hilbert curve by their mid-points
+    void sortEdgesSpatially(EdgeVec& edges) const;
+    /// Insert edges in the given order
+    void insertEdges_Ordered(const EdgeVec& edges);
+    /// Conform to edges in the given order
+    void conformToEdges_Ordered(const EdgeVec& edges);
+
     /**
      * Conform Delaunay triangulation to a fixed edge by recursively inserting
      * mid point of the edge and then conforming to its halves
@@ -438,19 +1008,62 @@ private:
         BoundaryOverlapCount overlaps,
         std::vector<ConformToEdgeTask>& remaining);
 
+    tuple<TriInd, VertInd, VertInd> checkIntersectedTriangle(
+        TriInd iT,
+        VertInd iA,
+        const V2d<T>& a,
+        const V2d<T>& b,
+        T orientationTolerance) const;
     tuple<TriInd, VertInd, VertInd> intersectedTriangle(
         VertInd iA,
-        const std::vector<TriInd>& candidates,
+        const AdjacentTriangles& candidates,
         const V2d<T>& a,
         const V2d<T>& b,
         T orientationTolerance = T(0)) const;
+    /// Find triangle that contains edge or is intersected by the edge first
+    tuple<TriInd, VertInd, VertInd> edgeStartTriangle(
+        VertInd iA,
+        VertInd iB,
+        TriInd iThint,
+        T orientationTolerance) const;
+    /// Check if valid triangle index is adjacent to the vertex
+    bool isAdjacentTriangle(TriInd iT, VertInd iV) const;
+    /// Check if vertex is a part of triangulation (was not removed)
+    bool hasAdjacentTriangles(VertInd iV) const;
+    /// Vertex close to the position to start walking from
+    VertInd nearVertex(const V2d<T>& pos) const;
+    /// Remove unused triangle by moving the last triangle in its place
+    void popTriangle(TriInd iT);
     /// Returns indices of three resulting triangles
     std::stack<TriInd> insertPointInTriangle(VertInd v, TriInd iT);
     /// Returns indices of four resulting triangles
     std::stack<TriInd> insertPointOnEdge(VertInd v, TriInd iT1, TriInd iT2);
     array<TriInd, 2> trianglesAt(const V2d<T>& pos) const;
     array<TriInd, 2> walkingSearchTrianglesAt(const V2d<T>& pos) const;
+    array<TriInd, 2>
+    walkingSearchTrianglesAt(const V2d<T>& pos, VertInd startVertex) const;
     TriInd walkTriangles(VertInd startVertex, const V2d<T>& pos) const;
+    /// Check all triangles for the one containing a point
+    TriangleLocation scanTrianglesAt(const V2d<T>& pos) const;
+    /// Triangle closest to a point out of a small sample of triangles
+    TriInd sampleStartTriangle(const V2d<T>& pos) const;
+    /**
+     * Locate a point
+     * @param isConvex triangulation is known to be convex: walk blocked by
+     * the boundary means that the point is outside. Walk that hits the step
+     * limit always falls back to checking all triangles.
+     */
+    TriangleLocation
+    locate(const V2d<T>& pos, TriInd hint, bool isConvex) const;
+    /// Check if triangulation is convex and has a single boundary loop
+    bool isConvex() const;
+    /// Locate points in a range, walk for each starts at the previous one
+    void locateRange(
+        const VertInd* first,
+        const VertInd* last,
+        const std::vector<V2d<T> >& positions,
+        bool isConvex,
+        TriangleLocation* locations) const;
     bool isFlipNeeded(
         const V2d<T>& v,
         VertInd iV,
@@ -475,6 +1088,15 @@ private:
         TriInd iT3,
         TriInd iT4);
     void removeAdjacentTriangle(VertInd iVertex, TriInd iTriangle);
+    /// Get one of the triangles adjacent to a vertex
+    TriInd adjacentTriangle(VertInd iVertex) const;
+    /**
+     * Get all triangles adjacent to a vertex
+     * @param buffer filled with triangles if they are not stored explicitly
+     * @return reference to the adjacent triangles
+     */
+    const AdjacentTriangles&
+    adjacentTriangles(VertInd iVertex, AdjacentTriangles& buffer) const;
     TriInd triangulatePseudopolygon(
         VertInd ia,
         VertInd ib,
@@ -491,12 +1113,38 @@ private:
     TriInd addTriangle(const Triangle& t); // note: invalidates iterators!
     TriInd addTriangle(); // note: invalidates triangle iterators!
     /**
-     * Remove super-triangle (if used) and triangles with specified indices.
+     * Remove flagged triangles: move kept triangles to the front and re-map
+     * triangles' neighbors, neighbors that are removed become noNeighbor
+     * @param removedTriangles flag for each triangle: true if triangle should
+     * be removed
+     * @return mapping from old to new triangle indices, noNeighbor for removed
+     * triangles
+     */
+    std::vector<TriInd> compactTriangles(
+        const std::vector<bool>& removedTriangles);
+    /**
+     * Remove super-triangle (if used) and flagged triangles.
      * Adjust internal triangulation state accordingly.
-     * @removedTriangles indices of triangles to remove
+     * @removedTriangles flag for each triangle: true if triangle should be
+     * removed
+     */
+    void finalizeTriangulation(const std::vector<bool>& removedTriangles);
+    /// Copy of triangulation finalized without modifying the original
+    Triangulation
+    finalizedCopy(const std::vector<bool>& removedTriangles) const;
+    /// Flag triangles adjacent to super-triangle's vertices
+    std::vector<bool> superTriangleTriangles() const;
+    /// Flag triangles outside of constrained boundary
+    std::vector<bool> outerTriangles(TraversalWorkspace& workspace) const;
+    /// Flag triangles outside of constrained boundary and in holes
+    std::vector<bool>
+    outerTrianglesAndHoles(TraversalWorkspace& workspace) const;
+    /**
+     * Flag triangles reachable from a seed without crossing fixed edges
+     * @param workspace its stack is used for the traversal
      */
-    void finalizeTriangulation(const TriIndUSet& removedTriangles);
-    TriIndUSet growToBoundary(std::stack<TriInd> seeds) const;
+    std::vector<bool>
+    growToBoundary(TriInd seed, TraversalWorkspace& workspace) const;
     void fixEdge(const Edge& edge, BoundaryOverlapCount overlaps);
     void fixEdge(const Edge& edge);
     void fixEdge(const Edge& edge, const Edge& originalEdge);
@@ -520,18 +1168,35 @@ private:
      * It takes starting seed triangles, traverses neighboring triangles, and
      * assigns given layer depth to the traversed triangles. Traversal is
      * blocked by constraint edges. Triangles behind constraint edges are
-     * recorded as seeds of next layer and returned from the function.
+     * recorded as seeds of deeper layers.
      *
-     * @param seeds indices of seed triangles
      * @param layerDepth current layer's depth to mark triangles with
      * @param[in, out] triDepths depths of triangles
-     * @return triangles of the deeper layers that are adjacent to the peeled
-     * layer. To be used as seeds when peeling deeper layers.
+     * @param[in, out] workspace its stack has seed triangles of the layer and
+     * is emptied, triangles of the deeper layers that are adjacent to the
+     * peeled layer are pushed to its heap of deeper seeds
      */
-    unordered_map<TriInd, LayerDepth> peelLayer(
-        std::stack<TriInd> seeds,
+    void peelLayer(
         LayerDepth layerDepth,
-        std::vector<LayerDepth>& triDepths) const;
+        std::vector<LayerDepth>& triDepths,
+        TraversalWorkspace& workspace) const;
+    /// Constraint edge between two regions and depth step of crossing it
+    typedef tuple<TriInd, TriInd, LayerDepth> DepthLink;
+    /**
+     * Join triangles in a range sharing non-constraint edges into regions
+     * @details Only parents of triangles in the range are modified, so
+     * ranges can be processed concurrently
+     * @param first first triangle of the range
+     * @param last one past the last triangle of the range
+     * @param[in, out] parent union-find parents of triangles
+     * @param[out] links links to triangles outside the range (zero step)
+     * and links across constraint edges
+     */
+    void linkTrianglesInRange(
+        TriInd first,
+        TriInd last,
+        std::vector<TriInd>& parent,
+        std::vector<DepthLink>& links) const;
 
     std::vector<TriInd> m_dummyTris;
     TNearPointLocator m_nearPtLocator;
@@ -540,6 +1205,43 @@ private:
     VertexInsertionOrder::Enum m_vertexInsertionOrder;
     IntersectingConstraintEdges::Enum m_intersectingEdgesStrategy;
     T m_minDistToConstraintEdge;
+    std::size_t m_maxSteinerPoints;
+    std::size_t m_steinerPointsLeft; ///< for the current conforming call
+    bool m_isConvex; ///< boundary is known to be convex, used by locate
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    /// outer triangles of pseudo-polygon edges that can't be found by vertex
+    std::vector<std::pair<Edge, TriInd> > m_extraOuterTris;
+#endif
+#ifndef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    /// cleared adjacency lists kept by reset to re-use their capacity
+    std::vector<AdjacentTriangles> m_vertTrisPool;
+#endif
+    // scratch buffers of inserting edges: shared between calls to avoid
+    // re-allocations
+    EdgeVec m_edgesBuf;             ///< edges in the order of insertion
+    EdgeVec m_remainingEdges;       ///< remaining parts of inserted edge
+    std::vector<TriangulatePseudopolygonTask> m_tppIterations;
+    std::vector<ConformToEdgeTask> m_remainingConformTasks;
+    std::vector<TriInd> m_intersectedTris; ///< triangles crossed by edge
+    std::vector<VertInd> m_polyLeft;       ///< pseudo-polygon left of edge
+    std::vector<VertInd> m_polyRight;      ///< pseudo-polygon right of edge
+    AdjacentTriangles m_aTrisBuf; ///< triangles adjacent to edge's 1st vertex
+    AdjacentTriangles m_bTrisBuf; ///< triangles adjacent to edge's 2nd vertex
+    TraversalWorkspace m_traversal; ///< used when erasing outer triangles
+    // scratch buffers of removing vertices
+    std::vector<TriInd> m_starTris;       ///< triangles around the vertex
+    std::vector<VertInd> m_cavityPoly;    ///< cavity polygon, ccw
+    std::vector<TriInd> m_cavityEdgeTris; ///< triangles outside of polygon
+    std::vector<Triangle> m_cavityTris;   ///< re-triangulated cavity
+    /// pairs of triangles sharing an edge that may need flipping
+    std::vector<std::pair<TriInd, TriInd> > m_flipCandidates;
+    // used by walkTriangles: allocated in class for zero-allocation walks
+    mutable std::vector<unsigned int> m_walkVisited; ///< walk stamp per tri
+    mutable unsigned int m_walkStamp;     ///< stamp of the current walk
+    mutable unsigned int m_walkRandState; ///< state of walk's random offsets
+    /// shuffles vertices for randomized insertion orders: per instance so
+    /// that independent triangulations can be used from different threads
+    mt19937 m_randGen;
 };
 
 /// @}
@@ -548,10 +1250,23 @@ private:
 namespace detail
 {
 
-static mt19937 randGenerator(9001);
+/// Seed of the generator shuffling vertices for randomized insertion
+const unsigned int shuffleSeed = 9001;
+
+/// Seed of the cheap pseudo-random generator used in triangulation walks
+const unsigned int walkRandSeed = 9001;
+
+/// Advance xorshift32 state and return the next pseudo-random number
+inline unsigned int xorshift32(unsigned int& state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
 
 template <class RandomIt>
-void random_shuffle(RandomIt first, RandomIt last)
+void random_shuffle(RandomIt first, RandomIt last, mt19937& randGenerator)
 {
     typename std::iterator_traits<RandomIt>::difference_type i, n;
     n = last - first;
@@ -566,12 +1281,12 @@ void random_shuffle(RandomIt first, RandomIt last)
 //-----------------------
 // Triangulation methods
 //-----------------------
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 template <
     typename TVertexIter,
     typename TGetVertexCoordX,
     typename TGetVertexCoordY>
-void Triangulation<T, TNearPointLocator>::insertVertices(
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVertices(
     const TVertexIter first,
     const TVertexIter last,
     TGetVertexCoordX getX,
@@ -583,7 +1298,11 @@ void Triangulation<T, TNearPointLocator>::insertVertices(
             "Triangulation was finalized with 'erase...' method. Inserting new "
             "vertices is not possible");
     }
-    detail::randGenerator.seed(9001); // ensure deterministic behavior
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    m_randGen.seed(detail::shuffleSeed); // ensure deterministic behavior
+    m_walkRandState = detail::walkRandSeed;
     if(vertices.empty())
     {
         addSuperTriangle(envelopBox<T>(first, last, getX, getY));
@@ -593,64 +1312,114 @@ void Triangulation<T, TNearPointLocator>::insertVertices(
 
     vertices.reserve(nExistingVerts + std::distance(first, last));
     for(TVertexIter it = first; it != last; ++it)
-        addNewVertex(V2d<T>::make(getX(*it), getY(*it)), TriIndVec());
+        addNewVertex(V2d<T>::make(getX(*it), getY(*it)), AdjacentTriangles());
+
+    insertVertices_Ordered(static_cast<VertInd>(nExistingVerts));
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+template <
+    typename TVertexIter,
+    typename TGetVertexCoordX,
+    typename TGetVertexCoordY>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVerticesParallel(
+    const TVertexIter first,
+    const TVertexIter last,
+    TGetVertexCoordX getX,
+    TGetVertexCoordY getY,
+    const std::size_t nThreads)
+{
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    if(!vertices.empty())
+        return insertVertices(first, last, getX, getY);
+    m_randGen.seed(detail::shuffleSeed); // ensure deterministic behavior
+    m_walkRandState = detail::walkRandSeed;
+    addSuperTriangle(envelopBox<T>(first, last, getX, getY));
+    vertices.reserve(vertices.size() + std::distance(first, last));
+    for(TVertexIter it = first; it != last; ++it)
+        addNewVertex(V2d<T>::make(getX(*it), getY(*it)), AdjacentTriangles());
+    insertVertices_Parallel(nThreads);
+}
 
-    switch(m_vertexInsertionOrder)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+template <
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd>
+void Triangulation<T, TNearPointLocator, TAllocator>::collectEdges(
+    TEdgeIter first,
+    const TEdgeIter last,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd,
+    EdgeVec& edges) const
+{
+    edges.clear();
+    for(; first != last; ++first)
     {
-    case VertexInsertionOrder::AsProvided:
-        for(TVertexIter it = first; it != last; ++it)
-            insertVertex(VertInd(nExistingVerts + std::distance(first, it)));
-        break;
-    case VertexInsertionOrder::Randomized:
-        std::vector<VertInd> ii(std::distance(first, last));
-        typedef std::vector<VertInd>::iterator Iter;
-        VertInd value = static_cast<VertInd>(nExistingVerts);
-        for(Iter it = ii.begin(); it != ii.end(); ++it, ++value)
-            *it = value;
-        detail::random_shuffle(ii.begin(), ii.end());
-        for(Iter it = ii.begin(); it != ii.end(); ++it)
-            insertVertex(*it);
-        break;
+        // +3 to account for super-triangle vertices
+        edges.push_back(Edge(
+            VertInd(getStart(*first) + m_nTargetVerts),
+            VertInd(getEnd(*first) + m_nTargetVerts)));
     }
 }
 
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 template <
     typename TEdgeIter,
     typename TGetEdgeVertexStart,
     typename TGetEdgeVertexEnd>
-void Triangulation<T, TNearPointLocator>::insertEdges(
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdges(
     TEdgeIter first,
     const TEdgeIter last,
     TGetEdgeVertexStart getStart,
     TGetEdgeVertexEnd getEnd)
 {
-    // state shared between different runs for performance gains
-    std::vector<TriangulatePseudopolygonTask> tppIterations;
-    EdgeVec remaining;
     if(isFinalized())
     {
         throw std::runtime_error(
             "Triangulation was finalized with 'erase...' method. Inserting new "
             "edges is not possible");
     }
-    for(; first != last; ++first)
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    collectEdges(first, last, getStart, getEnd, m_edgesBuf);
+    insertEdges_Ordered(m_edgesBuf);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+template <
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdgesBatch(
+    TEdgeIter first,
+    const TEdgeIter last,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd)
+{
+    if(isFinalized())
     {
-        // +3 to account for super-triangle vertices
-        const Edge edge(
-            VertInd(getStart(*first) + m_nTargetVerts),
-            VertInd(getEnd(*first) + m_nTargetVerts));
-        insertEdge(edge, edge, remaining, tppIterations);
+        throw std::runtime_error(
+            "Triangulation was finalized with 'erase...' method. Inserting new "
+            "edges is not possible");
     }
-    eraseDummies();
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    collectEdges(first, last, getStart, getEnd, m_edgesBuf);
+    sortEdgesSpatially(m_edgesBuf);
+    insertEdges_Ordered(m_edgesBuf);
 }
 
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 template <
     typename TEdgeIter,
     typename TGetEdgeVertexStart,
     typename TGetEdgeVertexEnd>
-void Triangulation<T, TNearPointLocator>::conformToEdges(
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdges(
     TEdgeIter first,
     const TEdgeIter last,
     TGetEdgeVertexStart getStart,
@@ -662,15 +1431,76 @@ void Triangulation<T, TNearPointLocator>::conformToEdges(
             "Triangulation was finalized with 'erase...' method. Conforming to "
             "new edges is not possible");
     }
-    // state shared between different runs for performance gains
-    std::vector<ConformToEdgeTask> remaining;
-    for(; first != last; ++first)
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    collectEdges(first, last, getStart, getEnd, m_edgesBuf);
+    conformToEdges_Ordered(m_edgesBuf);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+template <
+    typename TEdgeIter,
+    typename TGetEdgeVertexStart,
+    typename TGetEdgeVertexEnd>
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdgesBatch(
+    TEdgeIter first,
+    const TEdgeIter last,
+    TGetEdgeVertexStart getStart,
+    TGetEdgeVertexEnd getEnd)
+{
+    if(isFinalized())
     {
-        // +3 to account for super-triangle vertices
-        const Edge e(
-            VertInd(getStart(*first) + m_nTargetVerts),
-            VertInd(getEnd(*first) + m_nTargetVerts));
-        conformToEdge(e, EdgeVec(1, e), 0, remaining);
+        throw std::runtime_error(
+            "Triangulation was finalized with 'erase...' method. Conforming to "
+            "new edges is not possible");
+    }
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    collectEdges(first, last, getStart, getEnd, m_edgesBuf);
+    sortEdgesSpatially(m_edgesBuf);
+    conformToEdges_Ordered(m_edgesBuf);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+template <typename TVertIndIter>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertPolyline(
+    TVertIndIter first,
+    const TVertIndIter last,
+    const bool isClosed)
+{
+    if(isFinalized())
+    {
+        throw std::runtime_error(
+            "Triangulation was finalized with 'erase...' method. Inserting new "
+            "edges is not possible");
+    }
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    if(first == last)
+        return;
+    // +3 to account for super-triangle vertices
+    const VertInd iFirst = VertInd(*first + m_nTargetVerts);
+    VertInd iA = iFirst;
+    VertInd iSecond = iFirst;
+    // triangle adjacent to the current polyline vertex
+    TriInd iThint = noNeighbor;
+    for(++first; first != last; ++first)
+    {
+        const VertInd iB = VertInd(*first + m_nTargetVerts);
+        if(iSecond == iFirst)
+            iSecond = iB;
+        const Edge edge(iA, iB);
+        insertEdge(edge, edge, m_remainingEdges, m_tppIterations, iThint);
+        iA = iB;
+    }
+    // closing edge of a ring with less than 3 vertices is the first edge
+    if(isClosed && iA != iFirst && iA != iSecond)
+    {
+        const Edge edge(iA, iFirst);
+        insertEdge(edge, edge, m_remainingEdges, m_tppIterations, iThint);
     }
     eraseDummies();
 }
@@ -11,14 +11,14 @@
 
 #include <algorithm>
 #include <cassert>
-#include <deque>
+#include <cstddef>
+#include <functional>
+#include <limits>
 #include <stdexcept>
 
 namespace CDT
 {
 
-typedef std::deque<TriInd> TriDeque;
-
 namespace detail
 {
 
@@ -40,32 +40,45 @@ const VertexInsertionOrder::Enum vertexInsertionOrder =
 const IntersectingConstraintEdges::Enum intersectingEdgesStrategy =
     IntersectingConstraintEdges::Ignore;
 const float minDistToConstraintEdge(0);
+const std::size_t maxSteinerPoints = std::numeric_limits<std::size_t>::max();
 
 } // namespace defaults
 
 } // namespace detail
 
-template <typename T, typename TNearPointLocator>
-Triangulation<T, TNearPointLocator>::Triangulation()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::Triangulation()
     : m_nTargetVerts(detail::defaults::nTargetVerts)
     , m_superGeomType(detail::defaults::superGeomType)
     , m_vertexInsertionOrder(detail::defaults::vertexInsertionOrder)
     , m_intersectingEdgesStrategy(detail::defaults::intersectingEdgesStrategy)
     , m_minDistToConstraintEdge(detail::defaults::minDistToConstraintEdge)
+    , m_maxSteinerPoints(detail::defaults::maxSteinerPoints)
+    , m_steinerPointsLeft(detail::defaults::maxSteinerPoints)
+    , m_isConvex(false)
+    , m_walkStamp(0)
+    , m_walkRandState(detail::walkRandSeed)
+    , m_randGen(detail::shuffleSeed)
 {}
 
-template <typename T, typename TNearPointLocator>
-Triangulation<T, TNearPointLocator>::Triangulation(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::Triangulation(
     const VertexInsertionOrder::Enum vertexInsertionOrder)
     : m_nTargetVerts(detail::defaults::nTargetVerts)
     , m_superGeomType(detail::defaults::superGeomType)
     , m_vertexInsertionOrder(vertexInsertionOrder)
     , m_intersectingEdgesStrategy(detail::defaults::intersectingEdgesStrategy)
     , m_minDistToConstraintEdge(detail::defaults::minDistToConstraintEdge)
+    , m_maxSteinerPoints(detail::defaults::maxSteinerPoints)
+    , m_steinerPointsLeft(detail::defaults::maxSteinerPoints)
+    , m_isConvex(false)
+    , m_walkStamp(0)
+    , m_walkRandState(detail::walkRandSeed)
+    , m_randGen(detail::shuffleSeed)
 {}
 
-template <typename T, typename TNearPointLocator>
-Triangulation<T, TNearPointLocator>::Triangulation(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::Triangulation(
     const VertexInsertionOrder::Enum vertexInsertionOrder,
     const IntersectingConstraintEdges::Enum intersectingEdgesStrategy,
     const T minDistToConstraintEdge)
@@ -74,10 +87,16 @@ Triangulation<T, TNearPointLocator>::Triangulation(
     , m_vertexInsertionOrder(vertexInsertionOrder)
     , m_intersectingEdgesStrategy(intersectingEdgesStrategy)
     , m_minDistToConstraintEdge(minDistToConstraintEdge)
+    , m_maxSteinerPoints(detail::defaults::maxSteinerPoints)
+    , m_steinerPointsLeft(detail::defaults::maxSteinerPoints)
+    , m_isConvex(false)
+    , m_walkStamp(0)
+    , m_walkRandState(detail::walkRandSeed)
+    , m_randGen(detail::shuffleSeed)
 {}
 
-template <typename T, typename TNearPointLocator>
-Triangulation<T, TNearPointLocator>::Triangulation(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::Triangulation(
     const VertexInsertionOrder::Enum vertexInsertionOrder,
     const TNearPointLocator& nearPtLocator,
     const IntersectingConstraintEdges::Enum intersectingEdgesStrategy,
@@ -88,10 +107,16 @@ Triangulation<T, TNearPointLocator>::Triangulation(
     , m_vertexInsertionOrder(vertexInsertionOrder)
     , m_intersectingEdgesStrategy(intersectingEdgesStrategy)
     , m_minDistToConstraintEdge(minDistToConstraintEdge)
+    , m_maxSteinerPoints(detail::defaults::maxSteinerPoints)
+    , m_steinerPointsLeft(detail::defaults::maxSteinerPoints)
+    , m_isConvex(false)
+    , m_walkStamp(0)
+    , m_walkRandState(detail::walkRandSeed)
+    , m_randGen(detail::shuffleSeed)
 {}
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::changeNeighbor(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::changeNeighbor(
     const TriInd iT,
     const VertInd iVedge1,
     const VertInd iVedge2,
@@ -101,81 +126,160 @@ void Triangulation<T, TNearPointLocator>::changeNeighbor(
     t.neighbors[opposedTriangleInd(t, iVedge1, iVedge2)] = newNeighbor;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::eraseDummies()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::eraseDummies()
 {
     if(m_dummyTris.empty())
         return;
-    const TriIndUSet dummySet(m_dummyTris.begin(), m_dummyTris.end());
-    TriIndUMap triIndMap;
-    triIndMap[noNeighbor] = noNeighbor;
-    for(TriInd iT(0), iTnew(0); iT < TriInd(triangles.size()); ++iT)
-    {
-        if(dummySet.count(iT))
-            continue;
-        triIndMap[iT] = iTnew;
-        triangles[iTnew] = triangles[iT];
-        iTnew++;
-    }
-    triangles.erase(triangles.end() - dummySet.size(), triangles.end());
+    std::vector<bool> isDummy(triangles.size(), false);
+    typedef std::vector<TriInd>::const_iterator TriIndCit;
+    for(TriIndCit iT = m_dummyTris.begin(); iT != m_dummyTris.end(); ++iT)
+        isDummy[*iT] = true;
+    const std::vector<TriInd> triIndMap = compactTriangles(isDummy);
 
     // remap adjacent triangle indices for vertices
-    typedef typename VerticesTriangles::iterator VertTrisIt;
-    for(VertTrisIt vTris = vertTris.begin(); vTris != vertTris.end(); ++vTris)
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    typedef typename AdjacentTriangles::iterator TriIndIt;
+    for(TriIndIt iT = vertTris.begin(); iT != vertTris.end(); ++iT)
     {
-        for(TriIndVec::iterator iT = vTris->begin(); iT != vTris->end(); ++iT)
+        if(*iT != noNeighbor)
             *iT = triIndMap[*iT];
     }
-    // remap neighbor indices for triangles
-    for(TriangleVec::iterator t = triangles.begin(); t != triangles.end(); ++t)
+#else
+    typedef typename Adjacency::iterator VertTrisIt;
+    typedef typename AdjacentTriangles::iterator TriIndIt;
+    for(VertTrisIt vTris = vertTris.begin(); vTris != vertTris.end(); ++vTris)
     {
-        NeighborsArr3& nn = t->neighbors;
-        for(NeighborsArr3::iterator iN = nn.begin(); iN != nn.end(); ++iN)
-            *iN = triIndMap[*iN];
+        for(TriIndIt iT = vTris->begin(); iT != vTris->end(); ++iT)
+            *iT = triIndMap[*iT];
     }
+#endif
     // clear dummy triangles
     m_dummyTris = std::vector<TriInd>();
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::eraseSuperTriangle()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<bool>
+Triangulation<T, TNearPointLocator, TAllocator>::superTriangleTriangles() const
 {
-    if(m_superGeomType != SuperGeometryType::SuperTriangle)
-        return;
     // find triangles adjacent to super-triangle's vertices
-    TriIndUSet toErase;
-    toErase.reserve(
-        vertTris[0].size() + vertTris[1].size() + vertTris[2].size());
+    std::vector<bool> flags(triangles.size(), false);
     for(TriInd iT(0); iT < TriInd(triangles.size()); ++iT)
     {
-        Triangle& t = triangles[iT];
+        const Triangle& t = triangles[iT];
         if(t.vertices[0] < 3 || t.vertices[1] < 3 || t.vertices[2] < 3)
-            toErase.insert(iT);
+            flags[iT] = true;
     }
-    finalizeTriangulation(toErase);
+    return flags;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::eraseOuterTriangles()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<bool>
+Triangulation<T, TNearPointLocator, TAllocator>::outerTriangles(
+    TraversalWorkspace& workspace) const
 {
     // make dummy triangles adjacent to super-triangle's vertices
-    const std::stack<TriInd> seed(std::deque<TriInd>(1, vertTris[0].front()));
-    const TriIndUSet toErase = growToBoundary(seed);
-    finalizeTriangulation(toErase);
+    return growToBoundary(adjacentTriangle(0), workspace);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<bool>
+Triangulation<T, TNearPointLocator, TAllocator>::outerTrianglesAndHoles(
+    TraversalWorkspace& workspace) const
+{
+    std::vector<LayerDepth> triDepths;
+    calculateTriangleDepths(triDepths, workspace);
+    std::vector<bool> flags(triangles.size(), false);
+    for(std::size_t iT = 0; iT != triangles.size(); ++iT)
+    {
+        if(triDepths[iT] % 2 == 0)
+            flags[iT] = true;
+    }
+    return flags;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::eraseSuperTriangle()
+{
+    if(m_superGeomType != SuperGeometryType::SuperTriangle)
+        return;
+    finalizeTriangulation(superTriangleTriangles());
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::eraseOuterTriangles()
+{
+    finalizeTriangulation(outerTriangles(m_traversal));
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::eraseOuterTrianglesAndHoles()
+{
+    finalizeTriangulation(outerTrianglesAndHoles(m_traversal));
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::eraseOuterTrianglesAndHoles()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::eraseOuterTrianglesAndHolesParallel(
+    const std::size_t nThreads)
 {
-    const std::vector<LayerDepth> triDepths = calculateTriangleDepths();
-    TriIndUSet toErase;
-    toErase.reserve(triangles.size());
+    const std::vector<LayerDepth> triDepths =
+        calculateTriangleDepthsParallel(nThreads);
+    std::vector<bool> flags(triangles.size(), false);
     for(std::size_t iT = 0; iT != triangles.size(); ++iT)
     {
         if(triDepths[iT] % 2 == 0)
-            toErase.insert(static_cast<TriInd>(iT));
+            flags[iT] = true;
     }
-    finalizeTriangulation(toErase);
+    finalizeTriangulation(flags);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::withSuperTriangleErased() const
+{
+    if(m_superGeomType != SuperGeometryType::SuperTriangle)
+        return *this;
+    return finalizedCopy(superTriangleTriangles());
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::withOuterTrianglesErased() const
+{
+    TraversalWorkspace workspace;
+    return finalizedCopy(outerTriangles(workspace));
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::withOuterTrianglesAndHolesErased() const
+{
+    TraversalWorkspace workspace;
+    return finalizedCopy(outerTrianglesAndHoles(workspace));
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>
+Triangulation<T, TNearPointLocator, TAllocator>::finalizedCopy(
+    const std::vector<bool>& removedTriangles) const
+{
+    // adjacency and near-point locator are not needed after finalization:
+    // only copy the state that finalizing keeps
+    Triangulation out(
+        m_vertexInsertionOrder,
+        m_intersectingEdgesStrategy,
+        m_minDistToConstraintEdge);
+    out.vertices = vertices;
+    out.triangles = triangles;
+    out.fixedEdges = fixedEdges;
+    out.overlapCount = overlapCount;
+    out.pieceToOriginals = pieceToOriginals;
+    out.m_nTargetVerts = m_nTargetVerts;
+    out.m_superGeomType = m_superGeomType;
+    out.finalizeTriangulation(removedTriangles);
+    return out;
 }
 
 /// Remap removing super-triangle: subtract 3 from vertices
@@ -184,59 +288,83 @@ inline Edge RemapNoSuperTriangle(const Edge& e)
     return Edge(e.v1() - 3, e.v2() - 3);
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::removeTriangles(
-    const TriIndUSet& removedTriangles)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<TriInd>
+Triangulation<T, TNearPointLocator, TAllocator>::compactTriangles(
+    const std::vector<bool>& removedTriangles)
 {
-    if(removedTriangles.empty())
-        return;
-    // remove triangles and calculate triangle index mapping
-    TriIndUMap triIndMap;
-    for(TriInd iT(0), iTnew(0); iT < TriInd(triangles.size()); ++iT)
+    // move kept triangles to the front and calculate triangle index mapping
+    std::vector<TriInd> triIndMap(triangles.size(), noNeighbor);
+    TriInd iTnew(0);
+    for(TriInd iT(0); iT < TriInd(triangles.size()); ++iT)
     {
-        if(removedTriangles.count(iT))
+        if(removedTriangles[iT])
             continue;
         triIndMap[iT] = iTnew;
         triangles[iTnew] = triangles[iT];
-        iTnew++;
+        ++iTnew;
     }
-    triangles.erase(triangles.end() - removedTriangles.size(), triangles.end());
-    // adjust triangles' neighbors
-    vertTris = VerticesTriangles();
-    for(TriInd iT = 0; iT < triangles.size(); ++iT)
+    triangles.erase(triangles.begin() + iTnew, triangles.end());
+    // adjust triangles' neighbors: removed neighbors are mapped to noNeighbor
+    typedef typename Triangles::iterator TIt;
+    for(TIt t = triangles.begin(); t != triangles.end(); ++t)
     {
-        Triangle& t = triangles[iT];
-        // update neighbors to account for removed triangles
-        NeighborsArr3& nn = t.neighbors;
+        NeighborsArr3& nn = t->neighbors;
         for(NeighborsArr3::iterator n = nn.begin(); n != nn.end(); ++n)
         {
-            if(removedTriangles.count(*n))
-            {
-                *n = noNeighbor;
-            }
-            else if(*n != noNeighbor)
-            {
+            if(*n != noNeighbor)
                 *n = triIndMap[*n];
-            }
         }
     }
+    return triIndMap;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::finalizeTriangulation(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::removeTriangles(
     const TriIndUSet& removedTriangles)
+{
+    if(removedTriangles.empty())
+        return;
+    std::vector<bool> isRemoved(triangles.size(), false);
+    typedef TriIndUSet::const_iterator It;
+    for(It it = removedTriangles.begin(); it != removedTriangles.end(); ++it)
+        isRemoved[*it] = true;
+    removeTriangles(isRemoved);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::removeTriangles(
+    const std::vector<bool>& removedTriangles)
+{
+    if(std::find(removedTriangles.begin(), removedTriangles.end(), true) ==
+       removedTriangles.end())
+    {
+        return;
+    }
+    compactTriangles(removedTriangles);
+    vertTris = Adjacency();
+    m_isConvex = false;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::finalizeTriangulation(
+    const std::vector<bool>& removedTriangles)
 {
     eraseDummies();
     // remove super-triangle
     if(m_superGeomType == SuperGeometryType::SuperTriangle)
     {
         vertices.erase(vertices.begin(), vertices.begin() + 3);
-        if(removedTriangles.empty())
+        if(!vertTris.empty() &&
+           std::find(removedTriangles.begin(), removedTriangles.end(), true) ==
+               removedTriangles.end())
+        {
             vertTris.erase(vertTris.begin(), vertTris.begin() + 3);
+        }
         // Edge re-mapping
         { // fixed edges
-            EdgeUSet updatedFixedEdges;
-            typedef CDT::EdgeUSet::const_iterator It;
+            FixedEdges updatedFixedEdges;
+            typedef typename FixedEdges::const_iterator It;
             for(It e = fixedEdges.begin(); e != fixedEdges.end(); ++e)
             {
                 updatedFixedEdges.insert(RemapNoSuperTriangle(*e));
@@ -244,9 +372,8 @@ void Triangulation<T, TNearPointLocator>::finalizeTriangulation(
             fixedEdges = updatedFixedEdges;
         }
         { // overlap count
-            unordered_map<Edge, BoundaryOverlapCount> updatedOverlapCount;
-            typedef unordered_map<Edge, BoundaryOverlapCount>::const_iterator
-                It;
+            OverlapCounts updatedOverlapCount;
+            typedef typename OverlapCounts::const_iterator It;
             for(It it = overlapCount.begin(); it != overlapCount.end(); ++it)
             {
                 updatedOverlapCount.insert(std::make_pair(
@@ -255,8 +382,8 @@ void Triangulation<T, TNearPointLocator>::finalizeTriangulation(
             overlapCount = updatedOverlapCount;
         }
         { // split edges mapping
-            unordered_map<Edge, EdgeVec> updatedPieceToOriginals;
-            typedef unordered_map<Edge, EdgeVec>::const_iterator It;
+            PieceToOriginals updatedPieceToOriginals;
+            typedef typename PieceToOriginals::const_iterator It;
             for(It it = pieceToOriginals.begin(); it != pieceToOriginals.end();
                 ++it)
             {
@@ -277,8 +404,8 @@ void Triangulation<T, TNearPointLocator>::finalizeTriangulation(
     // adjust triangle vertices: account for removed super-triangle
     if(m_superGeomType == SuperGeometryType::SuperTriangle)
     {
-        for(TriangleVec::iterator t = triangles.begin(); t != triangles.end();
-            ++t)
+        typedef typename Triangles::iterator TIt;
+        for(TIt t = triangles.begin(); t != triangles.end(); ++t)
         {
             VerticesArr3& vv = t->vertices;
             for(VerticesArr3::iterator v = vv.begin(); v != vv.end(); ++v)
@@ -287,26 +414,57 @@ void Triangulation<T, TNearPointLocator>::finalizeTriangulation(
             }
         }
     }
+    m_isConvex = isConvex();
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::initializedWithCustomSuperGeometry()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::initializedWithCustomSuperGeometry()
 {
     m_nearPtLocator.initialize(vertices);
     m_nTargetVerts = vertices.size();
     m_superGeomType = SuperGeometryType::Custom;
+    m_isConvex = isConvex();
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::initializedWithSuperGeometry(
+    const SuperGeometryType::Enum superGeomType,
+    const std::size_t nSuperGeomVerts)
+{
+    m_nearPtLocator.initialize(vertices);
+    m_nTargetVerts = nSuperGeomVerts;
+    m_superGeomType = superGeomType;
+    m_isConvex = isConvex();
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::initializeSuperTriangle(
+    const Box2d<T>& box)
+{
+    if(!vertices.empty())
+    {
+        throw std::runtime_error(
+            "Super-triangle can only be initialized in an empty triangulation");
+    }
+    addSuperTriangle(box);
 }
 
-template <typename T, typename TNearPointLocator>
-TriIndUSet Triangulation<T, TNearPointLocator>::growToBoundary(
-    std::stack<TriInd> seeds) const
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<bool>
+Triangulation<T, TNearPointLocator, TAllocator>::growToBoundary(
+    const TriInd seed,
+    TraversalWorkspace& workspace) const
 {
-    TriIndUSet traversed;
+    std::vector<bool> traversed(triangles.size(), false);
+    std::vector<TriInd>& seeds = workspace.stack;
+    seeds.assign(1, seed);
     while(!seeds.empty())
     {
-        const TriInd iT = seeds.top();
-        seeds.pop();
-        traversed.insert(iT);
+        const TriInd iT = seeds.back();
+        seeds.pop_back();
+        traversed[iT] = true;
         const Triangle& t = triangles[iT];
         for(Index i(0); i < Index(3); ++i)
         {
@@ -314,15 +472,15 @@ TriIndUSet Triangulation<T, TNearPointLocator>::growToBoundary(
             if(fixedEdges.count(opEdge))
                 continue;
             const TriInd iN = t.neighbors[opoNbr(i)];
-            if(iN != noNeighbor && traversed.count(iN) == 0)
-                seeds.push(iN);
+            if(iN != noNeighbor && !traversed[iN])
+                seeds.push_back(iN);
         }
     }
     return traversed;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::makeDummy(const TriInd iT)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::makeDummy(const TriInd iT)
 {
     const Triangle& t = triangles[iT];
 
@@ -337,8 +495,9 @@ void Triangulation<T, TNearPointLocator>::makeDummy(const TriInd iT)
     m_dummyTris.push_back(iT);
 }
 
-template <typename T, typename TNearPointLocator>
-TriInd Triangulation<T, TNearPointLocator>::addTriangle(const Triangle& t)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd
+Triangulation<T, TNearPointLocator, TAllocator>::addTriangle(const Triangle& t)
 {
     if(m_dummyTris.empty())
     {
@@ -351,8 +510,8 @@ TriInd Triangulation<T, TNearPointLocator>::addTriangle(const Triangle& t)
     return nxtDummy;
 }
 
-template <typename T, typename TNearPointLocator>
-TriInd Triangulation<T, TNearPointLocator>::addTriangle()
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd Triangulation<T, TNearPointLocator, TAllocator>::addTriangle()
 {
     if(m_dummyTris.empty())
     {
@@ -367,27 +526,72 @@ TriInd Triangulation<T, TNearPointLocator>::addTriangle()
     return nxtDummy;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::insertEdges(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdges(
     const std::vector<Edge>& edges)
 {
     insertEdges(edges.begin(), edges.end(), edge_get_v1, edge_get_v2);
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::conformToEdges(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdges(
     const std::vector<Edge>& edges)
 {
     conformToEdges(edges.begin(), edges.end(), edge_get_v1, edge_get_v2);
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::fixEdge(const Edge& edge)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdgesBatch(
+    const std::vector<Edge>& edges)
 {
-    if(!fixedEdges.insert(edge).second)
-    {
-        ++overlapCount[edge]; // if edge is already fixed increment the counter
-    }
+    insertEdgesBatch(edges.begin(), edges.end(), edge_get_v1, edge_get_v2);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdgesBatch(
+    const std::vector<Edge>& edges)
+{
+    conformToEdgesBatch(edges.begin(), edges.end(), edge_get_v1, edge_get_v2);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::setMaxSteinerPoints(
+    const std::size_t maxSteinerPoints)
+{
+    m_maxSteinerPoints = maxSteinerPoints;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::size_t
+Triangulation<T, TNearPointLocator, TAllocator>::maxSteinerPoints() const
+{
+    return m_maxSteinerPoints;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertPolylines(
+    const std::vector<std::vector<VertInd> >& polylines)
+{
+    typedef std::vector<std::vector<VertInd> >::const_iterator Cit;
+    std::size_t nEdges = fixedEdges.size();
+    for(Cit it = polylines.begin(); it != polylines.end(); ++it)
+        nEdges += it->size();
+    fixedEdges.reserve(nEdges);
+    for(Cit it = polylines.begin(); it != polylines.end(); ++it)
+        insertPolyline(it->begin(), it->end(), false);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertRings(
+    const std::vector<std::vector<VertInd> >& rings)
+{
+    typedef std::vector<std::vector<VertInd> >::const_iterator Cit;
+    std::size_t nEdges = fixedEdges.size();
+    for(Cit it = rings.begin(); it != rings.end(); ++it)
+        nEdges += it->size();
+    fixedEdges.reserve(nEdges);
+    for(Cit it = rings.begin(); it != rings.end(); ++it)
+        insertPolyline(it->begin(), it->end(), true);
 }
 
 namespace detail
@@ -419,8 +623,371 @@ void insert_unique(
 
 } // namespace detail
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::fixEdge(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::removeVertex(
+    const VertInd iVertex)
+{
+    if(isFinalized())
+    {
+        throw std::runtime_error(
+            "Triangulation was finalized with 'erase...' method. Removing "
+            "vertices is not possible");
+    }
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    // +3 to account for super-triangle vertices
+    const VertInd iV = VertInd(iVertex + m_nTargetVerts);
+    if(iV >= vertices.size() || !hasAdjacentTriangles(iV))
+        throw std::runtime_error("Vertex is not in the triangulation");
+
+    // collect triangles around the vertex and the polygon formed by them
+    std::vector<TriInd>& starTris = m_starTris;
+    std::vector<VertInd>& poly = m_cavityPoly;
+    std::vector<TriInd>& polyEdgeTs = m_cavityEdgeTris;
+    starTris.clear();
+    poly.clear();
+    polyEdgeTs.clear();
+    const TriInd iTstart = adjacentTriangle(iV);
+    TriInd iT = iTstart;
+    do
+    {
+        const Triangle& t = triangles[iT];
+        const Index i = vertexInd(t, iV);
+        starTris.push_back(iT);
+        poly.push_back(t.vertices[ccw(i)]);
+        polyEdgeTs.push_back(t.neighbors[ccw(i)]);
+        iT = t.neighbors[cw(i)];
+    } while(iT != iTstart && iT != noNeighbor);
+    if(iT == noNeighbor)
+    {
+        throw std::runtime_error(
+            "Removing vertices on triangulation's boundary is not supported");
+    }
+
+    // Constraint edges ending at the vertex are removed with it unless the
+    // vertex splits a constraint edge in two (e.g., a Steiner point): then
+    // the pieces are merged into one constraint edge again.
+    const V2d<T>& v = vertices[iV];
+    std::size_t nFixed = 0;
+    bool isPiece = false;
+    VertInd iVfixed[2] = {noVertex, noVertex};
+    typedef std::vector<VertInd>::const_iterator VertIndCit;
+    for(VertIndCit it = poly.begin(); it != poly.end(); ++it)
+    {
+        const Edge edge(iV, *it);
+        if(!fixedEdges.count(edge))
+            continue;
+        if(nFixed < 2)
+            iVfixed[nFixed] = *it;
+        ++nFixed;
+        isPiece = isPiece || pieceToOriginals.count(edge);
+    }
+    bool isSplit = false;
+    EdgeVec mergedOriginals;
+    BoundaryOverlapCount mergedOverlaps = 0;
+    if(nFixed == 2)
+    {
+        const V2d<T>& a = vertices[iVfixed[0]];
+        const V2d<T>& b = vertices[iVfixed[1]];
+        const bool isBetween =
+            locatePointLine(v, a, b) == PtLineLocation::OnLine &&
+            (a.x - v.x) * (b.x - v.x) + (a.y - v.y) * (b.y - v.y) < T(0);
+        const Edge pieces[] = {Edge(iV, iVfixed[0]), Edge(iV, iVfixed[1])};
+        bool isSameOriginal = false;
+        for(int k = 0; k < 2; ++k)
+        {
+            const typename PieceToOriginals::const_iterator originalsIt =
+                pieceToOriginals.find(pieces[k]);
+            if(originalsIt == pieceToOriginals.end())
+                continue;
+            const EdgeVec& originals = originalsIt->second;
+            for(EdgeVec::const_iterator e = originals.begin();
+                e != originals.end();
+                ++e)
+            {
+                if(std::find(mergedOriginals.begin(), mergedOriginals.end(),
+                             *e) != mergedOriginals.end())
+                {
+                    isSameOriginal = true;
+                }
+            }
+            detail::insert_unique(mergedOriginals, originals);
+            const typename OverlapCounts::const_iterator
+                overlapsIt = overlapCount.find(pieces[k]);
+            if(overlapsIt != overlapCount.end())
+                mergedOverlaps = std::max(mergedOverlaps, overlapsIt->second);
+        }
+        isSplit = isBetween || isSameOriginal;
+    }
+    if(isPiece && !isSplit)
+    {
+        throw std::runtime_error(
+            "Removing vertices splitting more than one constraint edge is not "
+            "supported");
+    }
+
+    // Re-triangulate the polygon by cutting ears. Polygon is star-shaped with
+    // the removed vertex in its kernel: an ear is valid if it is convex and
+    // the vertex is not outside of the ear's base.
+    std::vector<Triangle>& cavityTris = m_cavityTris;
+    cavityTris.clear();
+    while(poly.size() > 3)
+    {
+        const std::size_t n = poly.size();
+        std::size_t iEar = 0;
+        for(; iEar < n; ++iEar)
+        {
+            const V2d<T>& p = vertices[poly[(iEar + n - 1) % n]];
+            const V2d<T>& q = vertices[poly[iEar]];
+            const V2d<T>& r = vertices[poly[(iEar + 1) % n]];
+            if(locatePointLine(q, p, r) == PtLineLocation::Right &&
+               locatePointLine(v, p, r) != PtLineLocation::Right)
+            {
+                break;
+            }
+        }
+        if(iEar == n)
+            throw std::runtime_error("Could not re-triangulate vertex cavity");
+        const std::size_t iPrev = (iEar + n - 1) % n;
+        const TriInd iTnew = starTris[cavityTris.size()];
+        const Triangle ear = {
+            {poly[iPrev], poly[iEar], poly[(iEar + 1) % n]},
+            {polyEdgeTs[iPrev], polyEdgeTs[iEar], noNeighbor}};
+        cavityTris.push_back(ear);
+        // ear's base becomes a polygon edge
+        poly.erase(poly.begin() + iEar);
+        polyEdgeTs[iPrev] = iTnew;
+        polyEdgeTs.erase(polyEdgeTs.begin() + iEar);
+    }
+    const Triangle last = {
+        {poly[0], poly[1], poly[2]},
+        {polyEdgeTs[0], polyEdgeTs[1], polyEdgeTs[2]}};
+    cavityTris.push_back(last);
+
+    // remove constraint edges ending at the vertex
+    for(TriIndVec::const_iterator it = starTris.begin(); it != starTris.end();
+        ++it)
+    {
+        const Triangle& t = triangles[*it];
+        const Edge edge(iV, t.vertices[ccw(vertexInd(t, iV))]);
+        if(fixedEdges.erase(edge))
+        {
+            overlapCount.erase(edge);
+            pieceToOriginals.erase(edge);
+        }
+    }
+#ifndef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    for(TriIndVec::const_iterator it = starTris.begin(); it != starTris.end();
+        ++it)
+    {
+        const Triangle& t = triangles[*it];
+        const Index i = vertexInd(t, iV);
+        removeAdjacentTriangle(t.vertices[ccw(i)], *it);
+        removeAdjacentTriangle(t.vertices[cw(i)], *it);
+    }
+    vertTris[iV].clear();
+#else
+    vertTris[iV] = noNeighbor;
+#endif
+
+    // write ears over the first triangles around the vertex
+    typedef std::vector<TriInd>::const_iterator TriIndCit;
+    const TriIndCit cavityBegin = starTris.begin();
+    const TriIndCit cavityEnd = starTris.begin() + cavityTris.size();
+    for(std::size_t i = 0; i < cavityTris.size(); ++i)
+    {
+        const TriInd iTear = starTris[i];
+        Triangle& t = triangles[iTear];
+        t = cavityTris[i];
+        // link ear's base to the ear that is cut later and shares it
+        for(std::size_t j = i + 1; j < cavityTris.size(); ++j)
+        {
+            const NeighborsArr3& nj = cavityTris[j].neighbors;
+            if(std::find(nj.begin(), nj.end(), iTear) != nj.end())
+            {
+                t.neighbors[2] = starTris[j];
+                break;
+            }
+        }
+        for(Index iN(0); iN < Index(3); ++iN)
+        {
+            const TriInd iTout = t.neighbors[iN];
+            if(iTout == noNeighbor ||
+               std::find(cavityBegin, cavityEnd, iTout) != cavityEnd)
+            {
+                continue;
+            }
+            // outer triangle: re-link to the ear
+            changeNeighbor(iTout, t.vertices[iN], t.vertices[ccw(iN)], iTear);
+        }
+        for(Index iV3(0); iV3 < Index(3); ++iV3)
+        {
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+            vertTris[t.vertices[iV3]] = iTear;
+#else
+            addAdjacentTriangle(t.vertices[iV3], iTear);
+#endif
+        }
+    }
+
+    // Restore Delaunay property by flipping edges. Edges outside of the
+    // cavity only need flipping when removed constraints were shielding them.
+    std::vector<std::pair<TriInd, TriInd> >& flipCandidates = m_flipCandidates;
+    flipCandidates.clear();
+    for(TriIndCit it = cavityBegin; it != cavityEnd; ++it)
+    {
+        const Triangle& t = triangles[*it];
+        for(Index iN(0); iN < Index(3); ++iN)
+            if(t.neighbors[iN] != noNeighbor)
+                flipCandidates.push_back(std::make_pair(*it, t.neighbors[iN]));
+    }
+    while(!flipCandidates.empty())
+    {
+        const TriInd iT1 = flipCandidates.back().first;
+        const TriInd iT2 = flipCandidates.back().second;
+        flipCandidates.pop_back();
+        const Triangle& t = triangles[iT1];
+        if(std::find(t.neighbors.begin(), t.neighbors.end(), iT2) ==
+           t.neighbors.end())
+        {
+            continue; // edge was flipped already
+        }
+        const Index iVopoInd = opposedVertexInd(t, iT2);
+        const VertInd iVopo = t.vertices[iVopoInd];
+        if(!isFlipNeeded(vertices[iVopo], iT1, iT2, iVopo))
+            continue;
+        // super-triangle's special cases can ask for flipping in a
+        // non-convex quadrilateral
+        const VertInd iVopo2 = opposedVertex(triangles[iT2], iT1);
+        const V2d<T>& v1 = vertices[iVopo];
+        const V2d<T>& v2 = vertices[iVopo2];
+        if(locatePointLine(vertices[t.vertices[ccw(iVopoInd)]], v1, v2) !=
+               PtLineLocation::Right ||
+           locatePointLine(vertices[t.vertices[cw(iVopoInd)]], v1, v2) !=
+               PtLineLocation::Left)
+        {
+            continue;
+        }
+        flipEdge(iT1, iT2);
+        CDT_STATS_ADD(flips, 1);
+        const TriInd flipped[] = {iT1, iT2};
+        for(int k = 0; k < 2; ++k)
+        {
+            const Triangle& tf = triangles[flipped[k]];
+            for(Index iN(0); iN < Index(3); ++iN)
+            {
+                const TriInd iTn = tf.neighbors[iN];
+                if(iTn != flipped[1 - k] && iTn != noNeighbor)
+                    flipCandidates.push_back(std::make_pair(flipped[k], iTn));
+            }
+        }
+    }
+
+    // two triangles around the vertex are left over
+    TriInd iTfree1 = starTris[starTris.size() - 2];
+    TriInd iTfree2 = starTris[starTris.size() - 1];
+    if(iTfree1 < iTfree2)
+        std::swap(iTfree1, iTfree2);
+    popTriangle(iTfree1);
+    popTriangle(iTfree2);
+    m_nearPtLocator.removePoint(iV, vertices);
+
+    if(!isSplit)
+        return;
+    // merge pieces of the split constraint edge
+    const Edge merged(iVfixed[0], iVfixed[1]);
+    TriInd iThint = noNeighbor;
+    insertEdge(merged, merged, m_remainingEdges, m_tppIterations, iThint);
+    eraseDummies();
+    if(mergedOverlaps > 0)
+        overlapCount[merged] = mergedOverlaps;
+    if(!mergedOriginals.empty() &&
+       mergedOriginals != EdgeVec(1, merged))
+    {
+        detail::insert_unique(pieceToOriginals[merged], mergedOriginals);
+    }
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::popTriangle(const TriInd iT)
+{
+    const TriInd iTlast = TriInd(triangles.size() - 1);
+    if(iT != iTlast)
+    {
+        const Triangle& t = triangles[iT] = triangles[iTlast];
+        for(Index i(0); i < Index(3); ++i)
+        {
+            changeNeighbor(t.neighbors[i], iTlast, iT);
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+            if(vertTris[t.vertices[i]] == iTlast)
+                vertTris[t.vertices[i]] = iT;
+#else
+            AdjacentTriangles& vTris = vertTris[t.vertices[i]];
+            std::replace(vTris.begin(), vTris.end(), iTlast, iT);
+#endif
+        }
+    }
+    triangles.pop_back();
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+bool Triangulation<T, TNearPointLocator, TAllocator>::hasAdjacentTriangles(
+    const VertInd iV) const
+{
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    return vertTris[iV] != noNeighbor;
+#else
+    return !vertTris[iV].empty();
+#endif
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+VertInd
+Triangulation<T, TNearPointLocator, TAllocator>::nearVertex(
+    const V2d<T>& pos) const
+{
+    const VertInd iV = m_nearPtLocator.nearPoint(pos, vertices);
+    // removed vertex can be found if locator was re-built after removal:
+    // fall back to a vertex of super-geometry that can't be removed
+    return hasAdjacentTriangles(iV) ? iV : VertInd(0);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdges_Ordered(
+    const EdgeVec& edges)
+{
+    for(EdgeVec::const_iterator e = edges.begin(); e != edges.end(); ++e)
+    {
+        TriInd iThint = noNeighbor;
+        insertEdge(*e, *e, m_remainingEdges, m_tppIterations, iThint);
+    }
+    eraseDummies();
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdges_Ordered(
+    const EdgeVec& edges)
+{
+    m_steinerPointsLeft = m_maxSteinerPoints;
+    for(EdgeVec::const_iterator e = edges.begin(); e != edges.end(); ++e)
+        conformToEdge(*e, EdgeVec(1, *e), 0, m_remainingConformTasks);
+    eraseDummies();
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::fixEdge(const Edge& edge)
+{
+    if(!fixedEdges.insert(edge).second)
+    {
+        ++overlapCount[edge]; // if edge is already fixed increment the counter
+    }
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::fixEdge(
     const Edge& edge,
     const Edge& originalEdge)
 {
@@ -429,8 +996,8 @@ void Triangulation<T, TNearPointLocator>::fixEdge(
         detail::insert_unique(pieceToOriginals[edge], originalEdge);
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::fixEdge(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::fixEdge(
     const Edge& edge,
     const BoundaryOverlapCount overlaps)
 {
@@ -475,26 +1042,29 @@ V2d<T> intersectionPosition(
 
 } // namespace detail
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdgeIteration(
     Edge edge,
     Edge originalEdge,
     EdgeVec& remaining,
-    std::vector<TriangulatePseudopolygonTask>& tppIterations)
+    std::vector<TriangulatePseudopolygonTask>& tppIterations,
+    TriInd& iThint)
 {
-    const VertInd iA = edge.v1();
+    VertInd iA = edge.v1();
     VertInd iB = edge.v2();
     if(iA == iB) // edge connects a vertex to itself
         return;
-    const TriIndVec& aTris = vertTris[iA];
-    const TriIndVec& bTris = vertTris[iB];
-    const V2d<T>& a = vertices[iA];
-    const V2d<T>& b = vertices[iB];
-    if(verticesShareEdge(aTris, bTris))
+    // start from the edge's vertex that the hint triangle is adjacent to
+    if(!isAdjacentTriangle(iThint, iA))
     {
-        fixEdge(edge, originalEdge);
-        return;
+        if(isAdjacentTriangle(iThint, iB))
+            std::swap(iA, iB);
+        else
+            iThint = adjacentTriangle(iA);
     }
+    const VertInd iEnd = iB;
+    const V2d<T>& a = vertices[iA];
+    const V2d<T>& b = vertices[iB];
 
     const T distanceTolerance =
         m_minDistToConstraintEdge == T(0)
@@ -504,18 +1074,24 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
     TriInd iT;
     VertInd iVleft, iVright;
     tie(iT, iVleft, iVright) =
-        intersectedTriangle(iA, aTris, a, b, distanceTolerance);
-    // if one of the triangle vertices is on the edge, move edge start
-    if(iT == noNeighbor)
+        edgeStartTriangle(iA, iB, iThint, distanceTolerance);
+    // edge exists or one of the triangle vertices is on the edge: move edge
+    // start to the vertex
+    if(iVleft == iVright)
     {
         const Edge edgePart(iA, iVleft);
         fixEdge(edgePart, originalEdge);
-        remaining.push_back(Edge(iVleft, iB));
+        if(iVleft != iB)
+            remaining.push_back(Edge(iVleft, iB));
+        iThint = iT;
         return;
     }
-    std::vector<TriInd> intersected(1, iT);
-    std::vector<VertInd> ptsLeft(1, iVleft);
-    std::vector<VertInd> ptsRight(1, iVright);
+    std::vector<TriInd>& intersected = m_intersectedTris;
+    std::vector<VertInd>& ptsLeft = m_polyLeft;
+    std::vector<VertInd>& ptsRight = m_polyRight;
+    intersected.assign(1, iT);
+    ptsLeft.assign(1, iVleft);
+    ptsRight.assign(1, iVright);
     VertInd iV = iA;
     Triangle t = triangles[iT];
     while(std::find(t.vertices.begin(), t.vertices.end(), iB) ==
@@ -546,7 +1122,7 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
             fixEdge(half2, overlaps);
             // maintain piece-to-original mapping
             EdgeVec newOriginals(1, splitEdge);
-            const unordered_map<Edge, EdgeVec>::const_iterator originalsIt =
+            const typename PieceToOriginals::const_iterator originalsIt =
                 pieceToOriginals.find(splitEdge);
             if(originalsIt != pieceToOriginals.end())
             { // edge being split was split before: pass-through originals
@@ -562,7 +1138,7 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
                 vertices[iB],
                 vertices[iVleft],
                 vertices[iVright]);
-            addNewVertex(newV, TriIndVec());
+            addNewVertex(newV, AdjacentTriangles());
             std::stack<TriInd> triStack =
                 insertPointOnEdge(iNewVert, iT, iTopo);
             ensureDelaunayByEdgeFlips(newV, iNewVert, triStack);
@@ -570,6 +1146,7 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
             //  for inserting [iA, iNewVert] edge half?
             remaining.push_back(Edge(iA, iNewVert));
             remaining.push_back(Edge(iNewVert, iB));
+            iThint = noNeighbor;
             return;
         }
 
@@ -599,6 +1176,40 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
     typedef std::vector<TriInd>::const_iterator TriIndCit;
     for(TriIndCit it = intersected.begin(); it != intersected.end(); ++it)
         makeDummy(*it);
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    // Attach each pseudo-polygon vertex to the outer triangle adjacent to
+    // the polygon edge starting at the vertex: it is used for looking up the
+    // outer triangles.
+    m_extraOuterTris.clear();
+    std::vector<TriInd> removed(intersected);
+    std::sort(removed.begin(), removed.end());
+    for(TriIndCit it = intersected.begin(); it != intersected.end(); ++it)
+    {
+        const Triangle& tRemoved = triangles[*it];
+        for(Index i(0); i < Index(3); ++i)
+            vertTris[tRemoved.vertices[i]] = noNeighbor;
+    }
+    for(TriIndCit it = intersected.begin(); it != intersected.end(); ++it)
+    {
+        const Triangle& tRemoved = triangles[*it];
+        for(Index i(0); i < Index(3); ++i)
+        {
+            const TriInd iTouter = tRemoved.neighbors[i];
+            if(iTouter == noNeighbor ||
+               std::binary_search(removed.begin(), removed.end(), iTouter))
+            {
+                continue;
+            }
+            // vertex can be visited by a pseudo-polygon more than once
+            const VertInd iV = tRemoved.vertices[ccw(i)];
+            if(vertTris[iV] == noNeighbor)
+                vertTris[iV] = iTouter;
+            else
+                m_extraOuterTris.push_back(std::make_pair(
+                    Edge(iV, tRemoved.vertices[i]), iTouter));
+        }
+    }
+#endif
     // Triangulate pseudo-polygons on both sides
     const TriInd iTleft = triangulatePseudopolygon(
         iA, iB, ptsLeft.begin(), ptsLeft.end(), noNeighbor, tppIterations);
@@ -607,13 +1218,23 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
         iB, iA, ptsRight.begin(), ptsRight.end(), noNeighbor, tppIterations);
     changeNeighbor(iTleft, noNeighbor, iTright);
     changeNeighbor(iTright, noNeighbor, iTleft);
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    // removed triangles were re-used: attach remaining vertices to them
+    for(TriIndCit it = intersected.begin(); it != intersected.end(); ++it)
+    {
+        const Triangle& tNew = triangles[*it];
+        for(Index i(0); i < Index(3); ++i)
+            addAdjacentTriangle(tNew.vertices[i], *it);
+    }
+#endif
+    iThint = iTleft;
 
-    if(iB != edge.v2()) // encountered point on the edge
+    if(iB != iEnd) // encountered point on the edge
     {
         // fix edge part
         const Edge edgePart(iA, iB);
         fixEdge(edgePart, originalEdge);
-        remaining.push_back(Edge(iB, edge.v2()));
+        remaining.push_back(Edge(iB, iEnd));
         return;
     }
     else
@@ -622,12 +1243,13 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
     }
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::insertEdge(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertEdge(
     Edge edge,
     const Edge originalEdge,
     EdgeVec& remaining,
-    std::vector<TriangulatePseudopolygonTask>& tppIterations)
+    std::vector<TriangulatePseudopolygonTask>& tppIterations,
+    TriInd& iThint)
 {
     // use iteration over recursion to avoid stack overflows
     remaining.clear();
@@ -636,12 +1258,13 @@ void Triangulation<T, TNearPointLocator>::insertEdge(
     {
         edge = remaining.back();
         remaining.pop_back();
-        insertEdgeIteration(edge, originalEdge, remaining, tppIterations);
+        insertEdgeIteration(
+            edge, originalEdge, remaining, tppIterations, iThint);
     }
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdgeIteration(
     Edge edge,
     const EdgeVec& originals,
     BoundaryOverlapCount overlaps,
@@ -651,11 +1274,14 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
     VertInd iB = edge.v2();
     if(iA == iB) // edge connects a vertex to itself
         return;
-    const TriIndVec& aTris = vertTris[iA];
-    const TriIndVec& bTris = vertTris[iB];
+    const AdjacentTriangles& aTris = adjacentTriangles(iA, m_aTrisBuf);
+    const AdjacentTriangles& bTris = adjacentTriangles(iB, m_bTrisBuf);
     const V2d<T>& a = vertices[iA];
     const V2d<T>& b = vertices[iB];
-    if(verticesShareEdge(aTris, bTris))
+    // vertices share an edge if they have a common adjacent triangle
+    if(std::find_first_of(
+           aTris.begin(), aTris.end(), bTris.begin(), bTris.end()) !=
+       aTris.end())
     {
         overlaps > 0 ? fixEdge(edge, overlaps) : fixEdge(edge);
         // avoid marking edge as a part of itself
@@ -688,6 +1314,9 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
         return;
     }
 
+    // remember crossed triangles: one of them contains edge's mid-point
+    std::vector<TriInd>& crossed = m_intersectedTris;
+    crossed.assign(1, iT);
     VertInd iV = iA;
     Triangle t = triangles[iT];
     while(std::find(t.vertices.begin(), t.vertices.end(), iB) ==
@@ -710,7 +1339,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
             const Edge half1(iVleft, iNewVert);
             const Edge half2(iNewVert, iVright);
 
-            const unordered_map<Edge, BoundaryOverlapCount>::const_iterator
+            const typename OverlapCounts::const_iterator
                 splitEdgeOverlapsIt = overlapCount.find(splitEdge);
             const BoundaryOverlapCount splitEdgeOverlaps =
                 splitEdgeOverlapsIt != overlapCount.end()
@@ -731,7 +1360,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
             }
             // maintain piece-to-original mapping
             EdgeVec newOriginals(1, splitEdge);
-            const unordered_map<Edge, EdgeVec>::const_iterator originalsIt =
+            const typename PieceToOriginals::const_iterator originalsIt =
                 pieceToOriginals.find(splitEdge);
             if(originalsIt != pieceToOriginals.end())
             { // edge being split was split before: pass-through originals
@@ -747,7 +1376,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
                 vertices[iB],
                 vertices[iVleft],
                 vertices[iVright]);
-            addNewVertex(newV, TriIndVec());
+            addNewVertex(newV, AdjacentTriangles());
             std::stack<TriInd> triStack =
                 insertPointOnEdge(iNewVert, iT, iTopo);
             ensureDelaunayByEdgeFlips(newV, iNewVert, triStack);
@@ -765,6 +1394,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
 
         iT = iTopo;
         t = triangles[iT];
+        crossed.push_back(iT);
 
         const PtLineLocation::Enum loc =
             locatePointLine(vOpo, a, b, distanceTolerance);
@@ -794,14 +1424,27 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
     }
 
     // add mid-point to triangulation
-    const VertInd iMid = static_cast<VertInd>(vertices.size());
+    if(m_steinerPointsLeft == 0)
+    {
+        // leave no dummy triangles behind: topology stays valid
+        eraseDummies();
+        throw std::runtime_error("Too many points added conforming to edges");
+    }
+    --m_steinerPointsLeft;
+    CDT_STATS_ADD(conformingSplits, 1);
+    const VertInd iMid = static_cast<VertInd>(vertices.size());
     const V2d<T>& start = vertices[iA];
     const V2d<T>& end = vertices[iB];
-    addNewVertex(
-        V2d<T>::make((start.x + end.x) / T(2), (start.y + end.y) / T(2)),
-        TriIndVec());
+    const V2d<T> mid =
+        V2d<T>::make((start.x + end.x) / T(2), (start.y + end.y) / T(2));
+    // mid-point is in one of the crossed triangles: no need to search
+    // triangulation, unless rounding moved it away from the edge
+    array<TriInd, 2> trisAt = candidateTrianglesAt(mid, crossed);
+    if(trisAt[0] == noNeighbor)
+        trisAt = walkingSearchTrianglesAt(mid, iA);
+    addNewVertex(mid, AdjacentTriangles());
     const std::vector<Edge> flippedFixedEdges =
-        insertVertex_FlipFixedEdges(iMid);
+        insertVertex_FlipFixedEdges(iMid, trisAt);
 
 #ifdef CDT_CXX11_IS_SUPPORTED
     remaining.emplace_back(Edge(iMid, iB), originals, overlaps);
@@ -821,7 +1464,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
         fixedEdges.erase(flippedFixedEdge);
 
         BoundaryOverlapCount prevOverlaps = 0;
-        const unordered_map<Edge, BoundaryOverlapCount>::const_iterator
+        const typename OverlapCounts::const_iterator
             overlapsIt = overlapCount.find(flippedFixedEdge);
         if(overlapsIt != overlapCount.end())
         {
@@ -830,7 +1473,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
         }
         // override overlapping boundaries count when re-inserting an edge
         EdgeVec prevOriginals(1, flippedFixedEdge);
-        const unordered_map<Edge, EdgeVec>::const_iterator originalsIt =
+        const typename PieceToOriginals::const_iterator originalsIt =
             pieceToOriginals.find(flippedFixedEdge);
         if(originalsIt != pieceToOriginals.end())
         {
@@ -845,8 +1488,8 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
     }
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::conformToEdge(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::conformToEdge(
     Edge edge,
     EdgeVec originals,
     BoundaryOverlapCount overlaps,
@@ -876,70 +1519,187 @@ void Triangulation<T, TNearPointLocator>::conformToEdge(
  *  - triangle index is no-neighbor (invalid)
  *  - index of point on the line
  *  - index of point on the right of the line
+ * If triangle is not intersected returns no-neighbor and no-vertex indices
  */
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 tuple<TriInd, VertInd, VertInd>
-Triangulation<T, TNearPointLocator>::intersectedTriangle(
+Triangulation<T, TNearPointLocator, TAllocator>::checkIntersectedTriangle(
+    const TriInd iT,
     const VertInd iA,
-    const std::vector<TriInd>& candidates,
     const V2d<T>& a,
     const V2d<T>& b,
     const T orientationTolerance) const
 {
-    typedef std::vector<TriInd>::const_iterator TriIndCit;
-    for(TriIndCit it = candidates.begin(); it != candidates.end(); ++it)
+    const Triangle& t = triangles[iT];
+    const Index i = vertexInd(t, iA);
+    const VertInd iP2 = t.vertices[ccw(i)];
+    const T orientP2 = orient2D(vertices[iP2], a, b);
+    const PtLineLocation::Enum locP2 = classifyOrientation(orientP2);
+    if(locP2 == PtLineLocation::Right)
     {
-        const TriInd iT = *it;
-        const Triangle t = triangles[iT];
-        const Index i = vertexInd(t, iA);
-        const VertInd iP2 = t.vertices[ccw(i)];
-        const T orientP2 = orient2D(vertices[iP2], a, b);
-        const PtLineLocation::Enum locP2 = classifyOrientation(orientP2);
-        if(locP2 == PtLineLocation::Right)
+        const VertInd iP1 = t.vertices[cw(i)];
+        const T orientP1 = orient2D(vertices[iP1], a, b);
+        const PtLineLocation::Enum locP1 = classifyOrientation(orientP1);
+        if(locP1 == PtLineLocation::OnLine)
         {
-            const VertInd iP1 = t.vertices[cw(i)];
-            const T orientP1 = orient2D(vertices[iP1], a, b);
-            const PtLineLocation::Enum locP1 = classifyOrientation(orientP1);
-            if(locP1 == PtLineLocation::OnLine)
-            {
-                return make_tuple(noNeighbor, iP1, iP1);
-            }
-            if(locP1 == PtLineLocation::Left)
+            return make_tuple(noNeighbor, iP1, iP1);
+        }
+        if(locP1 == PtLineLocation::Left)
+        {
+            if(orientationTolerance)
             {
-                if(orientationTolerance)
+                T closestOrient;
+                VertInd iClosestP;
+                if(std::abs(orientP1) <= std::abs(orientP2))
+                {
+                    closestOrient = orientP1;
+                    iClosestP = iP1;
+                }
+                else
+                {
+                    closestOrient = orientP2;
+                    iClosestP = iP2;
+                }
+                if(classifyOrientation(closestOrient, orientationTolerance) ==
+                   PtLineLocation::OnLine)
                 {
-                    T closestOrient;
-                    VertInd iClosestP;
-                    if(std::abs(orientP1) <= std::abs(orientP2))
-                    {
-                        closestOrient = orientP1;
-                        iClosestP = iP1;
-                    }
-                    else
-                    {
-                        closestOrient = orientP2;
-                        iClosestP = iP2;
-                    }
-                    if(classifyOrientation(
-                           closestOrient, orientationTolerance) ==
-                       PtLineLocation::OnLine)
-                    {
-                        return make_tuple(noNeighbor, iClosestP, iClosestP);
-                    }
+                    return make_tuple(noNeighbor, iClosestP, iClosestP);
                 }
-                return make_tuple(iT, iP1, iP2);
             }
+            return make_tuple(iT, iP1, iP2);
+        }
+    }
+    return make_tuple(noNeighbor, noVertex, noVertex);
+}
+
+/*!
+ * Returns same as checkIntersectedTriangle for the first of the candidates
+ * that is intersected by the line
+ */
+template <typename T, typename TNearPointLocator, typename TAllocator>
+tuple<TriInd, VertInd, VertInd>
+Triangulation<T, TNearPointLocator, TAllocator>::intersectedTriangle(
+    const VertInd iA,
+    const AdjacentTriangles& candidates,
+    const V2d<T>& a,
+    const V2d<T>& b,
+    const T orientationTolerance) const
+{
+    typedef typename AdjacentTriangles::const_iterator TriIndCit;
+    for(TriIndCit it = candidates.begin(); it != candidates.end(); ++it)
+    {
+        TriInd iT;
+        VertInd iP1, iP2;
+        tie(iT, iP1, iP2) =
+            checkIntersectedTriangle(*it, iA, a, b, orientationTolerance);
+        if(iP1 != noVertex)
+            return make_tuple(iT, iP1, iP2);
+    }
+    throw std::runtime_error("Could not find vertex triangle intersected by "
+                             "edge. Note: can be caused by duplicate points.");
+}
+
+/*!
+ * Walks around the edge's start vertex beginning with the hint triangle and
+ * turning towards the edge. Returns:
+ *  - triangle containing the edge and two edge end indices if edge exists
+ *  - triangle containing the point on the line and two point indices if
+ *    line goes through triangle's vertex
+ *  - intersected triangle index, index of point on the left of the line,
+ *    and index of point on the right of the line otherwise
+ */
+template <typename T, typename TNearPointLocator, typename TAllocator>
+tuple<TriInd, VertInd, VertInd>
+Triangulation<T, TNearPointLocator, TAllocator>::edgeStartTriangle(
+    const VertInd iA,
+    const VertInd iB,
+    const TriInd iThint,
+    const T orientationTolerance) const
+{
+    // check if edge exists without evaluating predicates
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    TriInd iT = iThint;
+    do
+    {
+        const Triangle& t = triangles[iT];
+        const Index i = vertexInd(t, iA);
+        if(t.vertices[ccw(i)] == iB || t.vertices[cw(i)] == iB)
+            return make_tuple(iT, iB, iB);
+        iT = t.neighbors[i];
+    } while(iT != iThint && iT != noNeighbor);
+    // vertex is on a boundary: walk around the vertex the other way too
+    if(iT == noNeighbor)
+    {
+        for(iT = iThint; iT != noNeighbor;)
+        {
+            const Triangle& t = triangles[iT];
+            const Index i = vertexInd(t, iA);
+            if(t.vertices[ccw(i)] == iB || t.vertices[cw(i)] == iB)
+                return make_tuple(iT, iB, iB);
+            iT = t.neighbors[cw(i)];
         }
     }
+#else
+    const AdjacentTriangles& aTris = vertTris[iA];
+    const AdjacentTriangles& bTris = vertTris[iB];
+    typedef typename AdjacentTriangles::const_iterator TriIndCit;
+    for(TriIndCit it = aTris.begin(); it != aTris.end(); ++it)
+        if(std::find(bTris.begin(), bTris.end(), *it) != bTris.end())
+            return make_tuple(*it, iB, iB);
+#endif
+    // walk from the hint triangle towards the edge: crossing triangle's edge
+    // that starts at the vertex turns clockwise
+    const V2d<T>& a = vertices[iA];
+    const V2d<T>& b = vertices[iB];
+    const Triangle& tHint = triangles[iThint];
+    const Index iHint = vertexInd(tHint, iA);
+    bool isClockwise =
+        locatePointLine(b, a, vertices[tHint.vertices[ccw(iHint)]]) ==
+        PtLineLocation::Right;
+    bool isTurned = false;
+    TriInd iTcurr = iThint;
+    do
+    {
+        TriInd iTisec;
+        VertInd iP1, iP2;
+        tie(iTisec, iP1, iP2) =
+            checkIntersectedTriangle(iTcurr, iA, a, b, orientationTolerance);
+        if(iP1 != noVertex)
+            return make_tuple(iTcurr, iP1, iP2);
+        const Triangle& t = triangles[iTcurr];
+        const Index i = vertexInd(t, iA);
+        iTcurr = t.neighbors[isClockwise ? i : cw(i)];
+        if(iTcurr == noNeighbor && !isTurned)
+        {
+            // reached boundary: walk from the hint triangle the other way
+            isClockwise = !isClockwise;
+            isTurned = true;
+            iTcurr = tHint.neighbors[isClockwise ? iHint : cw(iHint)];
+        }
+    } while(iTcurr != iThint && iTcurr != noNeighbor);
     throw std::runtime_error("Could not find vertex triangle intersected by "
                              "edge. Note: can be caused by duplicate points.");
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::addSuperTriangle(const Box2d<T>& box)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+bool Triangulation<T, TNearPointLocator, TAllocator>::isAdjacentTriangle(
+    const TriInd iT,
+    const VertInd iV) const
+{
+    if(iT == noNeighbor)
+        return false;
+    const VerticesArr3& vv = triangles[iT].vertices;
+    return std::find(vv.begin(), vv.end(), iV) != vv.end();
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::addSuperTriangle(
+    const Box2d<T>& box)
 {
     m_nTargetVerts = 3;
     m_superGeomType = SuperGeometryType::SuperTriangle;
+    m_isConvex = true;
 
     const V2d<T> center = {
         (box.min.x + box.max.x) / T(2), (box.min.y + box.max.y) / T(2)};
@@ -952,9 +1712,9 @@ void Triangulation<T, TNearPointLocator>::addSuperTriangle(const Box2d<T>& box)
     const V2d<T> posV1 = {center.x - shiftX, center.y - r};
     const V2d<T> posV2 = {center.x + shiftX, center.y - r};
     const V2d<T> posV3 = {center.x, center.y + R};
-    addNewVertex(posV1, TriIndVec(1, TriInd(0)));
-    addNewVertex(posV2, TriIndVec(1, TriInd(0)));
-    addNewVertex(posV3, TriIndVec(1, TriInd(0)));
+    addNewVertex(posV1, AdjacentTriangles(1, TriInd(0)));
+    addNewVertex(posV2, AdjacentTriangles(1, TriInd(0)));
+    addNewVertex(posV3, AdjacentTriangles(1, TriInd(0)));
     const Triangle superTri = {
         {VertInd(0), VertInd(1), VertInd(2)},
         {noNeighbor, noNeighbor, noNeighbor}};
@@ -962,24 +1722,72 @@ void Triangulation<T, TNearPointLocator>::addSuperTriangle(const Box2d<T>& box)
     m_nearPtLocator.initialize(vertices);
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::addNewVertex(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::addNewVertex(
     const V2d<T>& pos,
-    const TriIndVec& tris)
+    const AdjacentTriangles& tris)
 {
     vertices.push_back(pos);
-    vertTris.push_back(tris);
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    vertTris.push_back(tris.empty() ? noNeighbor : tris.front());
+#else
+    if(m_vertTrisPool.empty())
+    {
+        vertTris.push_back(tris);
+        return;
+    }
+    // re-use capacity of a list kept by reset
+    vertTris.push_back(AdjacentTriangles());
+    vertTris.back().swap(m_vertTrisPool.back());
+    m_vertTrisPool.pop_back();
+    vertTris.back().assign(tris.begin(), tris.end());
+#endif
 }
 
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 std::vector<Edge>
-Triangulation<T, TNearPointLocator>::insertVertex_FlipFixedEdges(
+Triangulation<T, TNearPointLocator, TAllocator>::insertVertex_FlipFixedEdges(
     const VertInd iVert)
+{
+    return insertVertex_FlipFixedEdges(
+        iVert, walkingSearchTrianglesAt(vertices[iVert]));
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+array<TriInd, 2>
+Triangulation<T, TNearPointLocator, TAllocator>::candidateTrianglesAt(
+    const V2d<T>& pos,
+    const std::vector<TriInd>& candidates) const
+{
+    array<TriInd, 2> out = {noNeighbor, noNeighbor};
+    typedef std::vector<TriInd>::const_iterator Cit;
+    for(Cit it = candidates.begin(); it != candidates.end(); ++it)
+    {
+        const Triangle& t = triangles[*it];
+        const PtTriLocation::Enum loc = locatePointTriangle(
+            pos,
+            vertices[t.vertices[0]],
+            vertices[t.vertices[1]],
+            vertices[t.vertices[2]]);
+        if(loc == PtTriLocation::Outside)
+            continue;
+        out[0] = *it;
+        if(isOnEdge(loc))
+            out[1] = t.neighbors[edgeNeighbor(loc)];
+        break;
+    }
+    return out;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<Edge>
+Triangulation<T, TNearPointLocator, TAllocator>::insertVertex_FlipFixedEdges(
+    const VertInd iVert,
+    const array<TriInd, 2>& trisAt)
 {
     std::vector<Edge> flippedFixedEdges;
 
     const V2d<T>& v = vertices[iVert];
-    array<TriInd, 2> trisAt = walkingSearchTrianglesAt(v);
     std::stack<TriInd> triStack =
         trisAt[1] == noNeighbor
             ? insertPointInTriangle(iVert, trisAt[0])
@@ -1021,6 +1829,7 @@ Triangulation<T, TNearPointLocator>::insertVertex_FlipFixedEdges(
                 flippedFixedEdges.push_back(flippedEdge);
 
             flipEdge(iT, iTopo);
+            CDT_STATS_ADD(flips, 1);
             triStack.push(iT);
             triStack.push(iTopo);
         }
@@ -1030,21 +1839,825 @@ Triangulation<T, TNearPointLocator>::insertVertex_FlipFixedEdges(
     return flippedFixedEdges;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::insertVertex(const VertInd iVert)
-{
-    const V2d<T>& v = vertices[iVert];
-    array<TriInd, 2> trisAt = walkingSearchTrianglesAt(v);
-    std::stack<TriInd> triStack =
-        trisAt[1] == noNeighbor
-            ? insertPointInTriangle(iVert, trisAt[0])
-            : insertPointOnEdge(iVert, trisAt[0], trisAt[1]);
-    ensureDelaunayByEdgeFlips(v, iVert, triStack);
-    m_nearPtLocator.addPoint(iVert, vertices);
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::insertVertex(
+    const VertInd iVert)
+{
+    const V2d<T>& v = vertices[iVert];
+    insertVertex(iVert, nearVertex(v));
+    m_nearPtLocator.addPoint(iVert, vertices);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVertex(
+    const VertInd iVert,
+    const VertInd walkStart)
+{
+    const V2d<T>& v = vertices[iVert];
+    array<TriInd, 2> trisAt = walkingSearchTrianglesAt(v, walkStart);
+    std::stack<TriInd> triStack =
+        trisAt[1] == noNeighbor
+            ? insertPointInTriangle(iVert, trisAt[0])
+            : insertPointOnEdge(iVert, trisAt[0], trisAt[1]);
+    ensureDelaunayByEdgeFlips(v, iVert, triStack);
+}
+
+namespace detail
+{
+
+/// Minimal size of a BRIO round: smaller rounds are merged into one
+const std::ptrdiff_t minBrioRoundSize = 64;
+
+/// Index of a cell of 2^16 x 2^16 grid along the Hilbert curve
+inline unsigned int hilbertIndex(unsigned int x, unsigned int y)
+{
+    const unsigned int n = 1u << 16;
+    unsigned int d = 0;
+    for(unsigned int s = n / 2; s > 0; s /= 2)
+    {
+        const unsigned int rx = (x & s) > 0;
+        const unsigned int ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // rotate quadrant so that the curve is continuous
+        if(ry == 0)
+        {
+            if(rx == 1)
+            {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+/// Sort vertex indices along Hilbert curve covering a given box
+template <typename T, typename TPoints>
+void hilbertSort(
+    const std::vector<VertInd>::iterator first,
+    const std::vector<VertInd>::iterator last,
+    const TPoints& vertices,
+    const Box2d<T>& box,
+    std::vector<std::pair<unsigned int, VertInd> >& keys)
+{
+    const T maxCell = T(65535);
+    const T w = box.max.x - box.min.x;
+    const T h = box.max.y - box.min.y;
+    const T scaleX = w > T(0) ? maxCell / w : T(0);
+    const T scaleY = h > T(0) ? maxCell / h : T(0);
+    keys.clear();
+    keys.reserve(std::distance(first, last));
+    typedef std::vector<VertInd>::iterator It;
+    for(It it = first; it != last; ++it)
+    {
+        const V2d<T>& v = vertices[*it];
+        const T cx = std::min((v.x - box.min.x) * scaleX, maxCell);
+        const T cy = std::min((v.y - box.min.y) * scaleY, maxCell);
+        keys.push_back(std::make_pair(
+            hilbertIndex(
+                static_cast<unsigned int>(cx), static_cast<unsigned int>(cy)),
+            *it));
+    }
+    std::sort(keys.begin(), keys.end());
+    It out = first;
+    typedef std::vector<std::pair<unsigned int, VertInd> >::const_iterator Cit;
+    for(Cit it = keys.begin(); it != keys.end(); ++it, ++out)
+        *out = it->second;
+}
+
+} // namespace detail
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::sortEdgesSpatially(
+    EdgeVec& edges) const
+{
+    if(edges.size() < 2)
+        return;
+    // sort edge mid-points: put them in a buffer, edge index is point index
+    V2dVec midPts;
+    midPts.reserve(edges.size());
+    for(EdgeVec::const_iterator e = edges.begin(); e != edges.end(); ++e)
+    {
+        const V2d<T>& v1 = vertices[e->v1()];
+        const V2d<T>& v2 = vertices[e->v2()];
+        midPts.push_back(V2d<T>::make(
+            v1.x / T(2) + v2.x / T(2), v1.y / T(2) + v2.y / T(2)));
+    }
+    std::vector<VertInd> ii(edges.size());
+    for(std::size_t i = 0; i < ii.size(); ++i)
+        ii[i] = VertInd(i);
+    std::vector<std::pair<unsigned int, VertInd> > keys;
+    detail::hilbertSort(
+        ii.begin(),
+        ii.end(),
+        midPts,
+        envelopBox<T>(midPts.begin(), midPts.end(), getX_V2d<T>, getY_V2d<T>),
+        keys);
+    const EdgeVec unsorted(edges);
+    for(std::size_t i = 0; i < ii.size(); ++i)
+        edges[i] = unsorted[ii[i]];
+}
+
+namespace detail
+{
+
+/// Order by vertex degree (then by index): degrees are taken from CSR offsets
+class LessByDegree
+{
+public:
+    explicit LessByDegree(const std::vector<std::size_t>& offsets)
+        : m_offsets(offsets)
+    {}
+    bool operator()(const VertInd a, const VertInd b) const
+    {
+        const std::size_t degA = m_offsets[a + 1] - m_offsets[a];
+        const std::size_t degB = m_offsets[b + 1] - m_offsets[b];
+        return degA != degB ? degA < degB : a < b;
+    }
+
+private:
+    const std::vector<std::size_t>& m_offsets;
+};
+
+/**
+ * Order vertices using reverse Cuthill-McKee algorithm
+ * @tparam TTriangles vector of triangles (with any allocator)
+ * @param triangles triangles connecting vertices
+ * @param nVertices number of vertices
+ * @param nFixed number of first vertices that keep their positions
+ * @return old vertex index by new vertex index
+ */
+template <typename TTriangles>
+std::vector<VertInd> reverseCuthillMcKee(
+    const TTriangles& triangles,
+    const std::size_t nVertices,
+    const VertInd nFixed)
+{
+    // vertex neighbors in CSR layout: ends of half-edges starting at vertex
+    // and starts of boundary half-edges ending at vertex
+    std::vector<std::size_t> offsets(nVertices + 1, 0);
+    typedef typename TTriangles::const_iterator TCit;
+    for(TCit t = triangles.begin(); t != triangles.end(); ++t)
+    {
+        for(Index i(0); i < Index(3); ++i)
+        {
+            ++offsets[t->vertices[i] + 1];
+            if(t->neighbors[i] == noNeighbor)
+                ++offsets[t->vertices[ccw(i)] + 1];
+        }
+    }
+    for(std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+    std::vector<VertInd> neighbors(offsets.back());
+    std::vector<std::size_t> ends(offsets.begin(), offsets.end() - 1);
+    for(TCit t = triangles.begin(); t != triangles.end(); ++t)
+    {
+        const VerticesArr3& vv = t->vertices;
+        for(Index i(0); i < Index(3); ++i)
+        {
+            neighbors[ends[vv[i]]++] = vv[ccw(i)];
+            if(t->neighbors[i] == noNeighbor)
+                neighbors[ends[vv[ccw(i)]]++] = vv[i];
+        }
+    }
+
+    // breadth-first traversal from minimal-degree vertices, neighbors are
+    // visited in the order of increasing degree
+    const LessByDegree lessByDegree(offsets);
+    std::vector<VertInd> starts;
+    starts.reserve(nVertices - nFixed);
+    for(VertInd v = nFixed; v < nVertices; ++v)
+        starts.push_back(v);
+    std::sort(starts.begin(), starts.end(), lessByDegree);
+    std::vector<bool> isVisited(nVertices, false);
+    std::vector<VertInd> order;
+    order.reserve(nVertices);
+    for(VertInd v(0); v < nFixed; ++v)
+        order.push_back(v);
+    typedef std::vector<VertInd>::const_iterator VCit;
+    for(VCit start = starts.begin(); start != starts.end(); ++start)
+    {
+        if(isVisited[*start])
+            continue;
+        isVisited[*start] = true;
+        order.push_back(*start);
+        for(std::size_t iHead = order.size() - 1; iHead < order.size(); ++iHead)
+        {
+            const VertInd v = order[iHead];
+            const std::size_t nOrdered = order.size();
+            for(std::size_t i = offsets[v]; i < offsets[v + 1]; ++i)
+            {
+                if(isVisited[neighbors[i]])
+                    continue;
+                isVisited[neighbors[i]] = true;
+                order.push_back(neighbors[i]);
+            }
+            std::sort(order.begin() + nOrdered, order.end(), lessByDegree);
+        }
+    }
+    std::reverse(order.begin() + nFixed, order.end());
+    return order;
+}
+
+/// Re-map edge's vertices
+inline Edge remapEdge(const Edge& e, const std::vector<VertInd>& mapping)
+{
+    return Edge(mapping[e.v1()], mapping[e.v2()]);
+}
+
+} // namespace detail
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+Reordering Triangulation<T, TNearPointLocator, TAllocator>::reorder(
+    const ReorderingStrategy::Enum strategy)
+{
+    if(!isFinalized())
+    {
+        throw std::runtime_error(
+            "Triangulation must be finalized with 'erase...' method before "
+            "re-ordering");
+    }
+    const VertInd nFixed(superGeometryVertexCount());
+    const std::size_t nVerts = vertices.size();
+    Reordering out;
+    if(strategy == ReorderingStrategy::Hilbert)
+    {
+        out.vertices.resize(nVerts);
+        for(std::size_t i = 0; i < nVerts; ++i)
+            out.vertices[i] = VertInd(i);
+        const Box2d<T> box = envelopBox<T>(
+            vertices.begin() + nFixed,
+            vertices.end(),
+            getX_V2d<T>,
+            getY_V2d<T>);
+        std::vector<std::pair<unsigned int, VertInd> > keys;
+        detail::hilbertSort(
+            out.vertices.begin() + nFixed,
+            out.vertices.end(),
+            vertices,
+            box,
+            keys);
+    }
+    else
+    {
+        out.vertices = detail::reverseCuthillMcKee(triangles, nVerts, nFixed);
+    }
+    std::vector<VertInd> newVertInds(nVerts);
+    for(std::size_t i = 0; i < nVerts; ++i)
+        newVertInds[out.vertices[i]] = VertInd(i);
+
+    // triangles are sorted by their smallest new vertex index
+    const std::size_t nTris = triangles.size();
+    std::vector<std::pair<VertInd, TriInd> > triKeys;
+    triKeys.reserve(nTris);
+    for(std::size_t iT = 0; iT < nTris; ++iT)
+    {
+        VerticesArr3& vv = triangles[iT].vertices;
+        for(Index i(0); i < Index(3); ++i)
+            vv[i] = newVertInds[vv[i]];
+        const VertInd vMin = std::min(std::min(vv[0], vv[1]), vv[2]);
+        triKeys.push_back(std::make_pair(vMin, TriInd(iT)));
+    }
+    std::sort(triKeys.begin(), triKeys.end());
+    out.triangles.resize(nTris);
+    std::vector<TriInd> newTriInds(nTris);
+    for(std::size_t i = 0; i < nTris; ++i)
+    {
+        out.triangles[i] = triKeys[i].second;
+        newTriInds[triKeys[i].second] = TriInd(i);
+    }
+    Triangles newTriangles;
+    newTriangles.reserve(nTris);
+    for(std::size_t i = 0; i < nTris; ++i)
+    {
+        Triangle t = triangles[out.triangles[i]];
+        for(Index j(0); j < Index(3); ++j)
+        {
+            if(t.neighbors[j] != noNeighbor)
+                t.neighbors[j] = newTriInds[t.neighbors[j]];
+        }
+        newTriangles.push_back(t);
+    }
+    triangles.swap(newTriangles);
+    V2dVec newVertices;
+    newVertices.reserve(nVerts);
+    for(std::size_t i = 0; i < nVerts; ++i)
+        newVertices.push_back(vertices[out.vertices[i]]);
+    vertices.swap(newVertices);
+
+    FixedEdges newFixedEdges;
+    typedef typename FixedEdges::const_iterator ECit;
+    for(ECit e = fixedEdges.begin(); e != fixedEdges.end(); ++e)
+        newFixedEdges.insert(detail::remapEdge(*e, newVertInds));
+    fixedEdges.swap(newFixedEdges);
+    OverlapCounts newOverlapCount;
+    typedef typename OverlapCounts::const_iterator OCit;
+    for(OCit it = overlapCount.begin(); it != overlapCount.end(); ++it)
+    {
+        newOverlapCount.insert(std::make_pair(
+            detail::remapEdge(it->first, newVertInds), it->second));
+    }
+    overlapCount.swap(newOverlapCount);
+    PieceToOriginals newPieceToOriginals;
+    typedef typename PieceToOriginals::const_iterator PCit;
+    for(PCit it = pieceToOriginals.begin(); it != pieceToOriginals.end();
+        ++it)
+    {
+        EdgeVec& originals =
+            newPieceToOriginals[detail::remapEdge(it->first, newVertInds)];
+        originals.reserve(it->second.size());
+        typedef EdgeVec::const_iterator EVCit;
+        for(EVCit e = it->second.begin(); e != it->second.end(); ++e)
+            originals.push_back(detail::remapEdge(*e, newVertInds));
+    }
+    pieceToOriginals.swap(newPieceToOriginals);
+    return out;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVertices_BRIO(
+    const VertInd iFirst)
+{
+    if(iFirst >= vertices.size())
+        return;
+    std::vector<VertInd> ii(vertices.size() - iFirst);
+    typedef std::vector<VertInd>::iterator Iter;
+    VertInd value = iFirst;
+    for(Iter it = ii.begin(); it != ii.end(); ++it, ++value)
+        *it = value;
+    detail::random_shuffle(ii.begin(), ii.end(), m_randGen);
+    // Split shuffled vertices into rounds: [.., n/8), [n/8, n/4), [n/4, n/2),
+    // [n/2, n) and sort each round along Hilbert curve
+    const Box2d<T> box = envelopBox<T>(
+        vertices.begin() + iFirst, vertices.end(), getX_V2d<T>, getY_V2d<T>);
+    std::vector<std::pair<unsigned int, VertInd> > keys;
+    Iter roundLast = ii.end();
+    while(roundLast - ii.begin() > detail::minBrioRoundSize)
+    {
+        const Iter roundFirst = ii.begin() + (roundLast - ii.begin()) / 2;
+        detail::hilbertSort(roundFirst, roundLast, vertices, box, keys);
+        roundLast = roundFirst;
+    }
+    detail::hilbertSort(ii.begin(), roundLast, vertices, box, keys);
+    // consecutive vertices are close: walk from the previous one
+    VertInd walkStart = nearVertex(vertices[ii[0]]);
+    // large batch: bulk-load near-point locator once all vertices are inserted
+    const bool isLocatorRebuilt = ii.size() >= iFirst;
+    for(Iter it = ii.begin(); it != ii.end(); ++it)
+    {
+        insertVertex(*it, walkStart);
+        if(!isLocatorRebuilt)
+            m_nearPtLocator.addPoint(*it, vertices);
+        walkStart = *it;
+    }
+    if(isLocatorRebuilt)
+        m_nearPtLocator.initialize(vertices);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVertices_Ordered(
+    const VertInd iFirst)
+{
+    switch(m_vertexInsertionOrder)
+    {
+    case VertexInsertionOrder::AsProvided:
+        for(VertInd iV = iFirst; iV < VertInd(vertices.size()); ++iV)
+            insertVertex(iV);
+        break;
+    case VertexInsertionOrder::Randomized:
+    {
+        std::vector<VertInd> ii(vertices.size() - iFirst);
+        typedef std::vector<VertInd>::iterator Iter;
+        VertInd value = iFirst;
+        for(Iter it = ii.begin(); it != ii.end(); ++it, ++value)
+            *it = value;
+        detail::random_shuffle(ii.begin(), ii.end(), m_randGen);
+        for(Iter it = ii.begin(); it != ii.end(); ++it)
+            insertVertex(*it);
+        break;
+    }
+    case VertexInsertionOrder::BRIO:
+        insertVertices_BRIO(iFirst);
+        break;
+    }
+}
+
+namespace detail
+{
+
+/// Minimal number of vertices in a strip triangulated by a separate thread
+const std::size_t minParallelStripSize = 1024;
+
+/// Compares vertex indices by x-coordinates of the vertices
+template <typename T, typename TPoints>
+struct LessByX
+{
+    explicit LessByX(const TPoints& vertices)
+        : vertices(vertices)
+    {}
+    bool operator()(const VertInd iA, const VertInd iB) const
+    {
+        return vertices[iA].x < vertices[iB].x;
+    }
+    const TPoints& vertices;
+};
+
+/// Checks if vertex with a given index lies left of a given x-coordinate
+template <typename T, typename TPoints>
+struct IsLeftOfX
+{
+    IsLeftOfX(const TPoints& vertices, const T x)
+        : vertices(vertices)
+        , x(x)
+    {}
+    bool operator()(const VertInd iV) const
+    {
+        return vertices[iV].x < x;
+    }
+    const TPoints& vertices;
+    T x;
+};
+
+/// Check if circumcircle of a triangle lies strictly inside of a box
+template <typename T>
+bool isCircumcircleInside(
+    const V2d<T>& a,
+    const V2d<T>& b,
+    const V2d<T>& c,
+    const Box2d<T>& box)
+{
+    // circumcenter relative to the first vertex
+    const T bx = b.x - a.x, by = b.y - a.y;
+    const T cx = c.x - a.x, cy = c.y - a.y;
+    const T d = T(2) * (bx * cy - by * cx);
+    if(d == T(0))
+        return false;
+    const T b2 = bx * bx + by * by;
+    const T c2 = cx * cx + cy * cy;
+    const T ux = (cy * b2 - by * c2) / d;
+    const T uy = (bx * c2 - cx * b2) / d;
+    const T r = std::sqrt(ux * ux + uy * uy);
+    return a.x + ux - r > box.min.x && a.x + ux + r < box.max.x &&
+           a.y + uy - r > box.min.y && a.y + uy + r < box.max.y;
+}
+
+} // namespace detail
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::triangulateStrip(
+    const std::vector<V2d<T> >& stripVertices)
+{
+#ifdef CDT_ENABLE_STATS
+    const detail::StatsScope statsScope(stats);
+#endif
+    const Box2d<T> box = envelopBox<T>(stripVertices);
+    addSuperTriangle(box);
+    vertices.reserve(vertices.size() + stripVertices.size());
+    typedef typename std::vector<V2d<T> >::const_iterator VCit;
+    for(VCit it = stripVertices.begin(); it != stripVertices.end(); ++it)
+        addNewVertex(*it, AdjacentTriangles());
+    // strip's own super-triangle and random generator are not shared with
+    // other threads: insert vertices sorted along Hilbert curve
+    std::vector<VertInd> ii(stripVertices.size());
+    typedef std::vector<VertInd>::iterator Iter;
+    VertInd value = VertInd(m_nTargetVerts);
+    for(Iter it = ii.begin(); it != ii.end(); ++it, ++value)
+        *it = value;
+    std::vector<std::pair<unsigned int, VertInd> > keys;
+    detail::hilbertSort(ii.begin(), ii.end(), vertices, box, keys);
+    VertInd walkStart(0);
+    for(Iter it = ii.begin(); it != ii.end(); ++it)
+    {
+        insertVertex(*it, walkStart);
+        walkStart = *it;
+    }
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void
+Triangulation<T, TNearPointLocator, TAllocator>::insertVertices_SerialFallback()
+{
+    const V2dVec added(vertices.begin() + m_nTargetVerts, vertices.end());
+    vertices.clear();
+    triangles.clear();
+    vertTris = Adjacency();
+    fixedEdges.clear();
+    overlapCount.clear();
+    pieceToOriginals.clear();
+    m_dummyTris.clear();
+    m_randGen.seed(detail::shuffleSeed); // ensure deterministic behavior
+    m_walkRandState = detail::walkRandSeed;
+    addSuperTriangle(envelopBox<T>(
+        added.begin(), added.end(), getX_V2d<T>, getY_V2d<T>));
+    vertices.reserve(vertices.size() + added.size());
+    typedef typename V2dVec::const_iterator VCit;
+    for(VCit it = added.begin(); it != added.end(); ++it)
+        addNewVertex(*it, AdjacentTriangles());
+    insertVertices_Ordered(VertInd(m_nTargetVerts));
+}
+
+/*!
+ * Vertices are split into vertical strips with non-overlapping x-ranges.
+ * Each strip is triangulated separately. Triangle of a strip is 'final' if it
+ * does not touch strip's super-triangle and its circumcircle lies strictly
+ * inside the x-range between neighboring strips and inside the bounding box
+ * of all vertices: such triangle is Delaunay in the whole triangulation.
+ * Vertices of the remaining triangles form the seams between the strips.
+ * Seam vertices are inserted into this triangulation and the boundaries of
+ * 'final' regions are inserted as constraints. Seam triangles inside the
+ * 'final' regions are then replaced with the strips' 'final' triangles.
+ */
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVertices_Parallel(
+    const std::size_t nThreads)
+{
+    typedef std::vector<VertInd>::iterator Iter;
+    const std::size_t nVerts = vertices.size() - m_nTargetVerts;
+    const std::size_t nStrips =
+        std::min(nThreads, nVerts / detail::minParallelStripSize);
+    if(nStrips < 2)
+        return insertVertices_Ordered(VertInd(m_nTargetVerts));
+
+    // split vertices into strips: [stripFirsts[k], stripFirsts[k + 1])
+    std::vector<VertInd> ii(nVerts);
+    VertInd value = VertInd(m_nTargetVerts);
+    for(Iter it = ii.begin(); it != ii.end(); ++it, ++value)
+        *it = value;
+    std::vector<Iter> stripFirsts(1, ii.begin());
+    for(std::size_t k = 1; k < nStrips; ++k)
+    {
+        const Iter stripFirst = stripFirsts.back();
+        Iter mid = ii.begin() + nVerts * k / nStrips;
+        if(mid <= stripFirst)
+            return insertVertices_Ordered(VertInd(m_nTargetVerts));
+        std::nth_element(
+            stripFirst, mid, ii.end(), detail::LessByX<T, V2dVec>(vertices));
+        // vertices with equal x-coordinates go to the same strip
+        const T x = vertices[*mid].x;
+        mid = std::partition(
+            stripFirst, mid, detail::IsLeftOfX<T, V2dVec>(vertices, x));
+        stripFirsts.push_back(mid);
+    }
+    stripFirsts.push_back(ii.end());
+    std::vector<std::vector<V2d<T> > > stripVerts(nStrips);
+    for(std::size_t k = 0; k < nStrips; ++k)
+    {
+        if(stripFirsts[k + 1] - stripFirsts[k] < 3)
+            return insertVertices_Ordered(VertInd(m_nTargetVerts));
+        stripVerts[k].reserve(stripFirsts[k + 1] - stripFirsts[k]);
+        for(Iter it = stripFirsts[k]; it != stripFirsts[k + 1]; ++it)
+            stripVerts[k].push_back(vertices[*it]);
+    }
+
+    // triangulate strips
+    std::vector<Triangulation> strips(nStrips);
+#ifdef CDT_CXX11_IS_SUPPORTED
+    detail::ThreadGroup threads(nStrips - 1);
+    for(std::size_t k = 1; k < nStrips; ++k)
+    {
+        threads.run(std::bind(
+            &Triangulation::triangulateStrip,
+            &strips[k],
+            std::cref(stripVerts[k])));
+    }
+    strips.front().triangulateStrip(stripVerts.front());
+    threads.join();
+#else
+    for(std::size_t k = 0; k < nStrips; ++k)
+        strips[k].triangulateStrip(stripVerts[k]);
+#endif
+#ifdef CDT_ENABLE_STATS
+    for(std::size_t k = 0; k < nStrips; ++k)
+        stats += strips[k].stats;
+#endif
+
+    // collect 'final' triangles and seam vertices
+    const Box2d<T> box = envelopBox<T>(
+        vertices.begin() + m_nTargetVerts,
+        vertices.end(),
+        getX_V2d<T>,
+        getY_V2d<T>);
+    const T margin = (box.max.x - box.min.x + box.max.y - box.min.y) *
+                     std::numeric_limits<T>::epsilon() * T(64);
+    TriangleVec finalTris;
+    // final triangle and its edge that borders the seam
+    std::vector<std::pair<TriInd, Index> > borders;
+    std::vector<bool> isSeam(vertices.size(), false);
+    for(std::size_t k = 0; k < nStrips; ++k)
+    {
+        const Triangulation& strip = strips[k];
+        Box2d<T> finalBox = box;
+        if(k > 0)
+            finalBox.min.x = envelopBox<T>(stripVerts[k - 1]).max.x;
+        if(k + 1 < nStrips)
+            finalBox.max.x = envelopBox<T>(stripVerts[k + 1]).min.x;
+        finalBox.min.x += margin;
+        finalBox.min.y += margin;
+        finalBox.max.x -= margin;
+        finalBox.max.y -= margin;
+        std::vector<TriInd> finalInds(strip.triangles.size(), noNeighbor);
+        TriInd iFinal = TriInd(finalTris.size());
+        for(TriInd iT(0); iT < TriInd(strip.triangles.size()); ++iT)
+        {
+            const VerticesArr3& vv = strip.triangles[iT].vertices;
+            if(vv[0] < 3 || vv[1] < 3 || vv[2] < 3)
+                continue;
+            const V2dVec& sv = strip.vertices;
+            if(detail::isCircumcircleInside(
+                   sv[vv[0]], sv[vv[1]], sv[vv[2]], finalBox))
+            {
+                finalInds[iT] = iFinal++;
+            }
+        }
+        // strip's vertex i has global index stripFirst[i - 3]
+        const Iter stripFirst = stripFirsts[k];
+        for(TriInd iT(0); iT < TriInd(strip.triangles.size()); ++iT)
+        {
+            Triangle t = strip.triangles[iT];
+            if(finalInds[iT] == noNeighbor)
+            {
+                for(Index i(0); i < Index(3); ++i)
+                    if(t.vertices[i] >= 3)
+                        isSeam[stripFirst[t.vertices[i] - 3]] = true;
+                continue;
+            }
+            for(Index i(0); i < Index(3); ++i)
+            {
+                t.vertices[i] = stripFirst[t.vertices[i] - 3];
+                TriInd& iN = t.neighbors[i];
+                iN = iN == noNeighbor ? noNeighbor : finalInds[iN];
+                if(iN == noNeighbor)
+                    borders.push_back(std::make_pair(finalInds[iT], i));
+            }
+            finalTris.push_back(t);
+        }
+    }
+    strips = std::vector<Triangulation>();
+    stripVerts = std::vector<std::vector<V2d<T> > >();
+
+    // insert seam vertices and borders of 'final' regions
+    std::vector<VertInd> seam;
+    for(VertInd iV = VertInd(m_nTargetVerts); iV < VertInd(vertices.size());
+        ++iV)
+    {
+        if(isSeam[iV])
+            seam.push_back(iV);
+    }
+    detail::random_shuffle(seam.begin(), seam.end(), m_randGen);
+    for(Iter it = seam.begin(); it != seam.end(); ++it)
+        insertVertex(*it);
+    const T minDistToConstraintEdge = m_minDistToConstraintEdge;
+    const IntersectingConstraintEdges::Enum intersectingEdgesStrategy =
+        m_intersectingEdgesStrategy;
+    m_minDistToConstraintEdge = T(0);
+    m_intersectingEdgesStrategy = IntersectingConstraintEdges::Ignore;
+    m_edgesBuf.clear();
+    typedef std::vector<std::pair<TriInd, Index> >::const_iterator BorderCit;
+    for(BorderCit it = borders.begin(); it != borders.end(); ++it)
+    {
+        const Triangle& t = finalTris[it->first];
+        m_edgesBuf.push_back(
+            Edge(t.vertices[it->second], t.vertices[ccw(it->second)]));
+    }
+    insertEdges_Ordered(m_edgesBuf);
+    m_minDistToConstraintEdge = minDistToConstraintEdge;
+    m_intersectingEdgesStrategy = intersectingEdgesStrategy;
+    // borders should not have been split
+    if(fixedEdges.size() != borders.size() || !pieceToOriginals.empty())
+        return insertVertices_SerialFallback();
+
+    // find seam triangles covering 'final' regions: left of the borders
+    std::vector<bool> isRemoved(triangles.size(), false);
+    std::vector<TriInd> outerTris; // seam triangles on the other side
+    outerTris.reserve(borders.size());
+    std::stack<TriInd> toRemove;
+    AdjacentTriangles aTrisBuf;
+    for(BorderCit it = borders.begin(); it != borders.end(); ++it)
+    {
+        const Triangle& t = finalTris[it->first];
+        const VertInd iA = t.vertices[it->second];
+        const VertInd iB = t.vertices[ccw(it->second)];
+        TriInd iInner = noNeighbor;
+        const AdjacentTriangles& aTris = adjacentTriangles(iA, aTrisBuf);
+        typedef typename AdjacentTriangles::const_iterator TriIndCit;
+        for(TriIndCit aT = aTris.begin(); aT != aTris.end(); ++aT)
+        {
+            const Triangle& aTri = triangles[*aT];
+            const Index i = vertexInd(aTri, iA);
+            if(aTri.vertices[ccw(i)] == iB)
+            {
+                iInner = *aT;
+                outerTris.push_back(aTri.neighbors[i]);
+                break;
+            }
+        }
+        if(iInner == noNeighbor)
+            return insertVertices_SerialFallback();
+        if(!isRemoved[iInner])
+        {
+            isRemoved[iInner] = true;
+            toRemove.push(iInner);
+        }
+    }
+    while(!toRemove.empty())
+    {
+        const Triangle& t = triangles[toRemove.top()];
+        toRemove.pop();
+        for(Index i(0); i < Index(3); ++i)
+        {
+            const TriInd iN = t.neighbors[i];
+            if(iN == noNeighbor || isRemoved[iN] ||
+               fixedEdges.count(Edge(t.vertices[i], t.vertices[ccw(i)])))
+            {
+                continue;
+            }
+            isRemoved[iN] = true;
+            toRemove.push(iN);
+        }
+    }
+    typedef std::vector<TriInd>::const_iterator TriCit;
+    for(TriCit it = outerTris.begin(); it != outerTris.end(); ++it)
+        if(*it == noNeighbor || isRemoved[*it])
+            return insertVertices_SerialFallback();
+    const std::size_t nRemoved = static_cast<std::size_t>(
+        std::count(isRemoved.begin(), isRemoved.end(), true));
+    // triangulation with super-triangle has 2 * nVertices - 5 triangles
+    if(triangles.size() - nRemoved + finalTris.size() !=
+       2 * vertices.size() - 5)
+    {
+        return insertVertices_SerialFallback();
+    }
+
+    // replace removed seam triangles with 'final' triangles
+    std::vector<TriInd> newInds(triangles.size(), noNeighbor);
+    Triangles merged;
+    merged.reserve(2 * vertices.size() - 5);
+    for(TriInd iT(0); iT < TriInd(triangles.size()); ++iT)
+    {
+        if(!isRemoved[iT])
+        {
+            newInds[iT] = TriInd(merged.size());
+            merged.push_back(triangles[iT]);
+        }
+    }
+    typedef typename Triangles::iterator TIt;
+    for(TIt t = merged.begin(); t != merged.end(); ++t)
+    {
+        NeighborsArr3& nn = t->neighbors;
+        for(NeighborsArr3::iterator iN = nn.begin(); iN != nn.end(); ++iN)
+            if(*iN != noNeighbor)
+                *iN = newInds[*iN];
+    }
+    const TriInd offset = TriInd(merged.size());
+    for(TriangleVec::iterator t = finalTris.begin(); t != finalTris.end(); ++t)
+    {
+        NeighborsArr3& nn = t->neighbors;
+        for(NeighborsArr3::iterator iN = nn.begin(); iN != nn.end(); ++iN)
+            if(*iN != noNeighbor)
+                *iN += offset;
+        merged.push_back(*t);
+    }
+    for(std::size_t i = 0; i < borders.size(); ++i)
+    {
+        const TriInd iT = borders[i].first + offset;
+        const TriInd iOuter = newInds[outerTris[i]];
+        Triangle& t = merged[iT];
+        t.neighbors[borders[i].second] = iOuter;
+        const VertInd iA = t.vertices[borders[i].second];
+        const VertInd iB = t.vertices[ccw(borders[i].second)];
+        Triangle& outer = merged[iOuter];
+        outer.neighbors[opposedTriangleInd(outer, iA, iB)] = iT;
+    }
+    triangles.swap(merged);
+    fixedEdges.clear();
+    overlapCount.clear();
+
+    // adjacent triangles and near-point locator for all vertices
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    for(TriInd iT(0); iT < TriInd(triangles.size()); ++iT)
+    {
+        const VerticesArr3& vv = triangles[iT].vertices;
+        for(VerticesArr3::const_iterator v = vv.begin(); v != vv.end(); ++v)
+            vertTris[*v] = iT;
+    }
+#else
+    typedef typename Adjacency::iterator VertTrisIt;
+    for(VertTrisIt vTris = vertTris.begin(); vTris != vertTris.end(); ++vTris)
+        vTris->clear();
+    for(TriInd iT(0); iT < TriInd(triangles.size()); ++iT)
+    {
+        const VerticesArr3& vv = triangles[iT].vertices;
+        for(VerticesArr3::const_iterator v = vv.begin(); v != vv.end(); ++v)
+            vertTris[*v].push_back(iT);
+    }
+#endif
+    m_nearPtLocator.initialize(vertices);
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::ensureDelaunayByEdgeFlips(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::ensureDelaunayByEdgeFlips(
     const V2d<T>& v,
     const VertInd iVert,
     std::stack<TriInd>& triStack)
@@ -1061,6 +2674,7 @@ void Triangulation<T, TNearPointLocator>::ensureDelaunayByEdgeFlips(
         if(isFlipNeeded(v, iT, iTopo, iVert))
         {
             flipEdge(iT, iTopo);
+            CDT_STATS_ADD(flips, 1);
             triStack.push(iT);
             triStack.push(iTopo);
         }
@@ -1090,8 +2704,8 @@ void Triangulation<T, TNearPointLocator>::ensureDelaunayByEdgeFlips(
  *                      \|/
  *                       v1
  */
-template <typename T, typename TNearPointLocator>
-bool Triangulation<T, TNearPointLocator>::isFlipNeeded(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+bool Triangulation<T, TNearPointLocator, TAllocator>::isFlipNeeded(
     const V2d<T>& v,
     const VertInd iV,
     const VertInd iV1,
@@ -1136,8 +2750,8 @@ bool Triangulation<T, TNearPointLocator>::isFlipNeeded(
     return isInCircumcircle(v, v1, v2, v3);
 }
 
-template <typename T, typename TNearPointLocator>
-bool Triangulation<T, TNearPointLocator>::isFlipNeeded(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+bool Triangulation<T, TNearPointLocator, TAllocator>::isFlipNeeded(
     const V2d<T>& v,
     const TriInd iT,
     const TriInd iTopo,
@@ -1185,8 +2799,9 @@ bool Triangulation<T, TNearPointLocator>::isFlipNeeded(
  *          v1 ___________________ v2
  *                     n1
  */
-template <typename T, typename TNearPointLocator>
-std::stack<TriInd> Triangulation<T, TNearPointLocator>::insertPointInTriangle(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::stack<TriInd>
+Triangulation<T, TNearPointLocator, TAllocator>::insertPointInTriangle(
     const VertInd v,
     const TriInd iT)
 {
@@ -1236,8 +2851,9 @@ std::stack<TriInd> Triangulation<T, TNearPointLocator>::insertPointInTriangle(
  *                   \|/
  *   T2 (bottom)      v3
  */
-template <typename T, typename TNearPointLocator>
-std::stack<TriInd> Triangulation<T, TNearPointLocator>::insertPointOnEdge(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::stack<TriInd>
+Triangulation<T, TNearPointLocator, TAllocator>::insertPointOnEdge(
     const VertInd v,
     const TriInd iT1,
     const TriInd iT2)
@@ -1283,47 +2899,317 @@ std::stack<TriInd> Triangulation<T, TNearPointLocator>::insertPointOnEdge(
     return newTriangles;
 }
 
-template <typename T, typename TNearPointLocator>
+namespace detail
+{
+
+/// Check if point is certainly to the right of edge: relative coordinates
+template <typename T>
+inline bool isCertainlyRight(const T acx, const T acy, const T bcx, const T bcy)
+{
+    T errBound;
+    const T det = orient2dFilter(acx, acy, bcx, bcy, errBound);
+    return (det < T(0)) & (-det >= errBound);
+}
+
+} // namespace detail
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriangleLocation
+Triangulation<T, TNearPointLocator, TAllocator>::scanTrianglesAt(
+    const V2d<T>& pos) const
+{
+    // Triangles are tested in chunks: vertices are packed as
+    // structure-of-arrays and the floating-point filter is evaluated for
+    // the whole chunk in a branch-free, vectorizable loop. Only triangles
+    // that are not certainly outside are tested with robust predicates.
+    const std::size_t chunk = detail::predicatesBatchSize;
+    T x[3][chunk], y[3][chunk];
+    bool isCandidate[chunk];
+    const std::size_t nTris = triangles.size();
+    for(std::size_t iChunk = 0; iChunk < nTris; iChunk += chunk)
+    {
+        const std::size_t n = std::min(chunk, nTris - iChunk);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            const VerticesArr3& vv = triangles[iChunk + i].vertices;
+            for(Index j = 0; j < Index(3); ++j)
+            {
+                x[j][i] = vertices[vv[j]].x - pos.x;
+                y[j][i] = vertices[vv[j]].y - pos.y;
+            }
+        }
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            using detail::isCertainlyRight;
+            isCandidate[i] =
+                !(isCertainlyRight(x[0][i], y[0][i], x[1][i], y[1][i]) |
+                  isCertainlyRight(x[1][i], y[1][i], x[2][i], y[2][i]) |
+                  isCertainlyRight(x[2][i], y[2][i], x[0][i], y[0][i]));
+        }
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            if(!isCandidate[i])
+                continue;
+            const TriInd iT(iChunk + i);
+            const Triangle& t = triangles[iT];
+            const V2d<T>& v1 = vertices[t.vertices[0]];
+            const V2d<T>& v2 = vertices[t.vertices[1]];
+            const V2d<T>& v3 = vertices[t.vertices[2]];
+            const PtTriLocation::Enum loc =
+                locatePointTriangle(pos, v1, v2, v3);
+            if(loc != PtTriLocation::Outside)
+                return TriangleLocation::make(iT, loc);
+        }
+    }
+    return TriangleLocation::make(noNeighbor, PtTriLocation::Outside);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
 array<TriInd, 2>
-Triangulation<T, TNearPointLocator>::trianglesAt(const V2d<T>& pos) const
+Triangulation<T, TNearPointLocator, TAllocator>::trianglesAt(
+    const V2d<T>& pos) const
 {
-    array<TriInd, 2> out = {noNeighbor, noNeighbor};
-    for(TriInd i = TriInd(0); i < TriInd(triangles.size()); ++i)
+    const TriangleLocation loc = scanTrianglesAt(pos);
+    if(loc.location == PtTriLocation::Outside)
+        throw std::runtime_error("No triangle was found at position");
+    array<TriInd, 2> out = {loc.triangle, noNeighbor};
+    if(isOnEdge(loc.location))
+        out[1] = triangles[loc.triangle].neighbors[edgeNeighbor(loc.location)];
+    return out;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd Triangulation<T, TNearPointLocator, TAllocator>::sampleStartTriangle(
+    const V2d<T>& pos) const
+{
+    // jump-and-walk: ~cube root of triangle count samples
+    const std::size_t nTris = triangles.size();
+    std::size_t nSamples = 1;
+    while(nSamples * nSamples * nSamples < nTris)
+        ++nSamples;
+    TriInd iBest(0);
+    T minDist = std::numeric_limits<T>::max();
+    for(std::size_t i = 0; i < nSamples; ++i)
     {
-        const Triangle& t = triangles[i];
-        const V2d<T>& v1 = vertices[t.vertices[0]];
-        const V2d<T>& v2 = vertices[t.vertices[1]];
-        const V2d<T>& v3 = vertices[t.vertices[2]];
-        const PtTriLocation::Enum loc = locatePointTriangle(pos, v1, v2, v3);
-        if(loc == PtTriLocation::Outside)
+        const TriInd iT(i * nTris / nSamples);
+        const T dist =
+            distanceSquared(pos, vertices[triangles[iT].vertices[0]]);
+        if(dist < minDist)
+        {
+            minDist = dist;
+            iBest = iT;
+        }
+    }
+    return iBest;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+bool Triangulation<T, TNearPointLocator, TAllocator>::isConvex() const
+{
+    // boundary edges (without neighbor) keyed by start vertex
+    std::vector<VertInd> next(vertices.size(), noVertex);
+    VertInd iStart = noVertex;
+    std::size_t nBoundaryEdges = 0;
+    typedef typename Triangles::const_iterator TCit;
+    for(TCit t = triangles.begin(); t != triangles.end(); ++t)
+    {
+        for(Index i(0); i < Index(3); ++i)
+        {
+            if(t->neighbors[i] != noNeighbor)
+                continue;
+            const VertInd a = t->vertices[i];
+            if(next[a] != noVertex)
+                return false; // boundary touches itself
+            next[a] = t->vertices[ccw(i)];
+            iStart = a;
+            ++nBoundaryEdges;
+        }
+    }
+    // single boundary loop turning left (or straight) at each vertex
+    VertInd a = iStart;
+    for(std::size_t i = 0; i < nBoundaryEdges; ++i)
+    {
+        const VertInd b = next[a];
+        const VertInd c = next[b];
+        if(c == noVertex)
+            return false;
+        const PtLineLocation::Enum turn =
+            locatePointLine(vertices[c], vertices[a], vertices[b]);
+        if(turn == PtLineLocation::Right)
+            return false;
+        a = b;
+        if(a == iStart && i + 1 < nBoundaryEdges)
+            return false; // more than one loop
+    }
+    return true;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriangleLocation Triangulation<T, TNearPointLocator, TAllocator>::locate(
+    const V2d<T>& pos,
+    const TriInd hint) const
+{
+    return locate(pos, hint, m_isConvex);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriangleLocation Triangulation<T, TNearPointLocator, TAllocator>::locate(
+    const V2d<T>& pos,
+    const TriInd hint,
+    const bool isConvex) const
+{
+    if(triangles.empty())
+        return TriangleLocation::make(noNeighbor, PtTriLocation::Outside);
+    TriInd iT = hint < triangles.size() ? hint : sampleStartTriangle(pos);
+    // Stochastic visibility walk: terminates also in non-Delaunay
+    // triangulations and doesn't need marking visited triangles, so no
+    // state is shared between concurrent calls. The number of steps is
+    // limited as a safe-guard.
+    unsigned int randState = detail::walkRandSeed;
+    bool isBlockedByBoundary = false;
+    for(std::size_t step = 0; step < triangles.size(); ++step)
+    {
+        const Triangle& t = triangles[iT];
+        const Index offset(detail::xorshift32(randState) % 3);
+        TriInd iNext = iT;
+        bool isBlocked = false;
+        for(Index i_(0); i_ < Index(3); ++i_)
+        {
+            const Index i((i_ + offset) % 3);
+            const V2d<T>& vStart = vertices[t.vertices[i]];
+            const V2d<T>& vEnd = vertices[t.vertices[ccw(i)]];
+            if(locatePointLine(pos, vStart, vEnd) != PtLineLocation::Right)
+                continue;
+            if(t.neighbors[i] == noNeighbor)
+            {
+                isBlocked = true;
+                continue;
+            }
+            iNext = t.neighbors[i];
+            break;
+        }
+        if(iNext != iT)
+        {
+            iT = iNext;
             continue;
-        out[0] = i;
-        if(isOnEdge(loc))
-            out[1] = t.neighbors[edgeNeighbor(loc)];
-        return out;
+        }
+        if(isBlocked)
+        {
+            isBlockedByBoundary = true;
+            break;
+        }
+        const PtTriLocation::Enum loc = locatePointTriangle(
+            pos,
+            vertices[t.vertices[0]],
+            vertices[t.vertices[1]],
+            vertices[t.vertices[2]]);
+        if(loc != PtTriLocation::Outside)
+            return TriangleLocation::make(iT, loc);
+        break;
+    }
+    if(isBlockedByBoundary && isConvex)
+        return TriangleLocation::make(noNeighbor, PtTriLocation::Outside);
+    // walk hit the boundary of a triangulation that is not known to be
+    // convex or didn't finish within the step limit
+    return scanTrianglesAt(pos);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriangleLocation Triangulation<T, TNearPointLocator, TAllocator>::locate(
+    const V2d<T>& pos,
+    const TriangleLocation& hint) const
+{
+    return locate(pos, hint.triangle);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::locateRange(
+    const VertInd* first,
+    const VertInd* const last,
+    const std::vector<V2d<T> >& positions,
+    const bool isConvex,
+    TriangleLocation* const locations) const
+{
+    TriInd hint = noNeighbor;
+    for(; first != last; ++first)
+    {
+        const TriangleLocation loc =
+            locate(positions[*first], hint, isConvex);
+        locations[*first] = loc;
+        if(loc.triangle != noNeighbor)
+            hint = loc.triangle;
+    }
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<TriangleLocation>
+Triangulation<T, TNearPointLocator, TAllocator>::locateMany(
+    const std::vector<V2d<T> >& positions,
+    std::size_t nThreads) const
+{
+    const std::size_t n = positions.size();
+    std::vector<TriangleLocation> locations(
+        n, TriangleLocation::make(noNeighbor, PtTriLocation::Outside));
+    if(n == 0)
+        return locations;
+    std::vector<VertInd> ii(n);
+    for(std::size_t i = 0; i < n; ++i)
+        ii[i] = VertInd(i);
+    {
+        std::vector<std::pair<unsigned int, VertInd> > keys;
+        const Box2d<T> box = envelopBox(positions);
+        detail::hilbertSort(ii.begin(), ii.end(), positions, box, keys);
+    }
+    // points outside of convex triangulation are found without scanning
+    const bool isConvexTriangulation = m_isConvex || isConvex();
+    nThreads = std::max(std::min(nThreads, n), std::size_t(1));
+    const VertInd* const sorted = &ii[0];
+    TriangleLocation* const out = &locations[0];
+#ifdef CDT_CXX11_IS_SUPPORTED
+    detail::ThreadGroup threads(nThreads - 1);
+    for(std::size_t k = 1; k < nThreads; ++k)
+    {
+        threads.run(std::bind(
+            &Triangulation::locateRange,
+            this,
+            sorted + n * k / nThreads,
+            sorted + n * (k + 1) / nThreads,
+            std::cref(positions),
+            isConvexTriangulation,
+            out));
     }
-    throw std::runtime_error("No triangle was found at position");
+    locateRange(
+        sorted, sorted + n / nThreads, positions, isConvexTriangulation, out);
+    threads.join();
+#else
+    locateRange(sorted, sorted + n, positions, isConvexTriangulation, out);
+#endif
+    return locations;
 }
 
-template <typename T, typename TNearPointLocator>
-TriInd Triangulation<T, TNearPointLocator>::walkTriangles(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd Triangulation<T, TNearPointLocator, TAllocator>::walkTriangles(
     const VertInd startVertex,
     const V2d<T>& pos) const
 {
     // begin walk in search of triangle at pos
-    TriInd currTri = vertTris[startVertex][0];
-#ifdef CDT_USE_BOOST
-    TriIndFlatUSet visited;
-#else
-    TriIndUSet visited;
-#endif
+    TriInd currTri = adjacentTriangle(startVertex);
+    // triangles visited in this walk are marked with the walk's stamp
+    if(m_walkVisited.size() < triangles.size())
+        m_walkVisited.resize(triangles.capacity(), 0);
+    if(++m_walkStamp == 0) // stamp overflow: clear stale marks
+    {
+        std::fill(m_walkVisited.begin(), m_walkVisited.end(), 0);
+        m_walkStamp = 1;
+    }
     bool found = false;
     while(!found)
     {
+        CDT_STATS_ADD(walkSteps, 1);
         const Triangle& t = triangles[currTri];
         found = true;
         // stochastic offset to randomize which edge we check first
-        const Index offset(detail::randGenerator() % 3);
+        const Index offset(detail::xorshift32(m_walkRandState) % 3);
         for(Index i_(0); i_ < Index(3); ++i_)
         {
             const Index i((i_ + offset) % 3);
@@ -1333,10 +3219,11 @@ TriInd Triangulation<T, TNearPointLocator>::walkTriangles(
                 locatePointLine(pos, vStart, vEnd);
             if(edgeCheck == PtLineLocation::Right &&
                t.neighbors[i] != noNeighbor &&
-               visited.insert(t.neighbors[i]).second)
+               m_walkVisited[t.neighbors[i]] != m_walkStamp)
             {
                 found = false;
                 currTri = t.neighbors[i];
+                m_walkVisited[currTri] = m_walkStamp;
                 break;
             }
         }
@@ -1344,13 +3231,23 @@ TriInd Triangulation<T, TNearPointLocator>::walkTriangles(
     return currTri;
 }
 
-template <typename T, typename TNearPointLocator>
-array<TriInd, 2> Triangulation<T, TNearPointLocator>::walkingSearchTrianglesAt(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+array<TriInd, 2>
+Triangulation<T, TNearPointLocator, TAllocator>::walkingSearchTrianglesAt(
     const V2d<T>& pos) const
 {
-    array<TriInd, 2> out = {noNeighbor, noNeighbor};
     // Query  for a vertex close to pos, to start the search
-    const VertInd startVertex = m_nearPtLocator.nearPoint(pos, vertices);
+    const VertInd startVertex = nearVertex(pos);
+    return walkingSearchTrianglesAt(pos, startVertex);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+array<TriInd, 2>
+Triangulation<T, TNearPointLocator, TAllocator>::walkingSearchTrianglesAt(
+    const V2d<T>& pos,
+    const VertInd startVertex) const
+{
+    array<TriInd, 2> out = {noNeighbor, noNeighbor};
     const TriInd iT = walkTriangles(startVertex, pos);
     // Finished walk, locate point in current triangle
     const Triangle& t = triangles[iT];
@@ -1382,8 +3279,8 @@ array<TriInd, 2> Triangulation<T, TNearPointLocator>::walkingSearchTrianglesAt(
  *               \|/
  *                v2
  */
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::flipEdge(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::flipEdge(
     const TriInd iT,
     const TriInd iTopo)
 {
@@ -1422,8 +3319,8 @@ void Triangulation<T, TNearPointLocator>::flipEdge(
     }
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::changeNeighbor(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::changeNeighbor(
     const TriInd iT,
     const TriInd oldNeighbor,
     const TriInd newNeighbor)
@@ -1434,55 +3331,144 @@ void Triangulation<T, TNearPointLocator>::changeNeighbor(
     t.neighbors[neighborInd(t, oldNeighbor)] = newNeighbor;
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::addAdjacentTriangle(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::addAdjacentTriangle(
     const VertInd iVertex,
     const TriInd iTriangle)
 {
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    if(vertTris[iVertex] == noNeighbor)
+        vertTris[iVertex] = iTriangle;
+#else
     vertTris[iVertex].push_back(iTriangle);
+#endif
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::addAdjacentTriangles(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::addAdjacentTriangles(
     const VertInd iVertex,
     const TriInd iT1,
     const TriInd iT2,
     const TriInd iT3)
 {
-    TriIndVec& vTris = vertTris[iVertex];
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    addAdjacentTriangle(iVertex, iT1);
+    (void)iT2;
+    (void)iT3;
+#else
+    AdjacentTriangles& vTris = vertTris[iVertex];
     vTris.reserve(vTris.size() + 3);
     vTris.push_back(iT1);
     vTris.push_back(iT2);
     vTris.push_back(iT3);
+#endif
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::addAdjacentTriangles(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::addAdjacentTriangles(
     const VertInd iVertex,
     const TriInd iT1,
     const TriInd iT2,
     const TriInd iT3,
     const TriInd iT4)
 {
-    TriIndVec& vTris = vertTris[iVertex];
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    addAdjacentTriangle(iVertex, iT1);
+    (void)iT2;
+    (void)iT3;
+    (void)iT4;
+#else
+    AdjacentTriangles& vTris = vertTris[iVertex];
     vTris.reserve(vTris.size() + 4);
     vTris.push_back(iT1);
     vTris.push_back(iT2);
     vTris.push_back(iT3);
     vTris.push_back(iT4);
+#endif
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::removeAdjacentTriangle(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::removeAdjacentTriangle(
     const VertInd iVertex,
     const TriInd iTriangle)
 {
-    std::vector<TriInd>& tris = vertTris[iVertex];
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    TriInd& iT = vertTris[iVertex];
+    if(iT != iTriangle)
+        return;
+    // re-attach vertex to a neighbor triangle that contains the vertex
+    iT = noNeighbor;
+    const Triangle& t = triangles[iTriangle];
+    typedef NeighborsArr3::const_iterator NCit;
+    for(NCit iN = t.neighbors.begin(); iN != t.neighbors.end(); ++iN)
+    {
+        if(*iN == noNeighbor)
+            continue;
+        const VerticesArr3& vv = triangles[*iN].vertices;
+        if(std::find(vv.begin(), vv.end(), iVertex) != vv.end())
+        {
+            iT = *iN;
+            return;
+        }
+    }
+#else
+    AdjacentTriangles& tris = vertTris[iVertex];
     tris.erase(std::find(tris.begin(), tris.end(), iTriangle));
+#endif
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd Triangulation<T, TNearPointLocator, TAllocator>::adjacentTriangle(
+    const VertInd iVertex) const
+{
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    return vertTris[iVertex];
+#else
+    return vertTris[iVertex].front();
+#endif
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+const typename Triangulation<T, TNearPointLocator, TAllocator>::
+    AdjacentTriangles&
+    Triangulation<T, TNearPointLocator, TAllocator>::adjacentTriangles(
+        const VertInd iVertex,
+        AdjacentTriangles& buffer) const
+{
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    // walk around the vertex counter-clockwise
+    buffer.clear();
+    const TriInd iTstart = vertTris[iVertex];
+    TriInd iT = iTstart;
+    do
+    {
+        buffer.push_back(iT);
+        const Triangle& t = triangles[iT];
+        iT = t.neighbors[vertexInd(t, iVertex)];
+    } while(iT != iTstart && iT != noNeighbor);
+    if(iT == noNeighbor)
+    {
+        // vertex is on a boundary: walk around the vertex clockwise too
+        iT = iTstart;
+        while(true)
+        {
+            const Triangle& t = triangles[iT];
+            iT = t.neighbors[cw(vertexInd(t, iVertex))];
+            if(iT == noNeighbor)
+                break;
+            buffer.push_back(iT);
+        }
+    }
+    return buffer;
+#else
+    (void)buffer;
+    return vertTris[iVertex];
+#endif
 }
 
-template <typename T, typename TNearPointLocator>
-TriInd Triangulation<T, TNearPointLocator>::triangulatePseudopolygon(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd
+Triangulation<T, TNearPointLocator, TAllocator>::triangulatePseudopolygon(
     VertInd ia,
     VertInd ib,
     std::vector<VertInd>::const_iterator pointsFirst,
@@ -1497,19 +3483,30 @@ TriInd Triangulation<T, TNearPointLocator>::triangulatePseudopolygon(
     typedef std::vector<VertInd>::const_iterator CIter;
     iterations.clear();
     iterations.push_back(make_tuple(ia, ib, pointsFirst, pointsLast, parent));
+    CDT_STATS_ADD(pseudopolygons, 1);
 
     while(!iterations.empty())
     {
+        CDT_STATS_MAX(pseudopolygonMaxDepth, iterations.size());
         tie(ia, ib, pointsFirst, pointsLast, parent) = iterations.back();
         iterations.pop_back();
         // check if pseudo-polygon is a single triangle
         if(pointsFirst == pointsLast)
         {
             const TriInd outerTri = pseudopolyOuterTriangle(ia, ib);
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+            // no outer triangle: edge is inside, other side is not added yet
+            if(outerTri == noNeighbor)
+            {
+                const Edge e(ia, ib);
+                m_extraOuterTris.push_back(std::make_pair(e, parent));
+            }
+#endif
             if(parent != noNeighbor)
             {
                 changeNeighbor(parent, ia, ib, outerTri);
-                changeNeighbor(outerTri, ia, ib, parent);
+                if(outerTri != noNeighbor)
+                    changeNeighbor(outerTri, ia, ib, parent);
             }
             continue;
         }
@@ -1523,9 +3520,11 @@ TriInd Triangulation<T, TNearPointLocator>::triangulatePseudopolygon(
         Triangle& t = triangles[iT];
         using detail::arr3;
         t.vertices = arr3(ia, ib, ic);
+#ifndef CDT_USE_COMPACT_VERTEX_ADJACENCY
         addAdjacentTriangle(ia, iT);
         addAdjacentTriangle(ib, iT);
         addAdjacentTriangle(ic, iT);
+#endif
         // adjust neighboring triangles and vertices
         t.neighbors[0] = parent;
         if(parent != noNeighbor)
@@ -1542,9 +3541,9 @@ TriInd Triangulation<T, TNearPointLocator>::triangulatePseudopolygon(
     return out;
 }
 
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 std::vector<VertInd>::const_iterator
-Triangulation<T, TNearPointLocator>::findDelaunayPoint(
+Triangulation<T, TNearPointLocator, TAllocator>::findDelaunayPoint(
     const V2d<T>& a,
     const V2d<T>& b,
     std::vector<VertInd>::const_iterator pointsFirst,
@@ -1565,48 +3564,131 @@ Triangulation<T, TNearPointLocator>::findDelaunayPoint(
     return cIt;
 }
 
-template <typename T, typename TNearPointLocator>
-TriInd Triangulation<T, TNearPointLocator>::pseudopolyOuterTriangle(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+TriInd Triangulation<T, TNearPointLocator, TAllocator>::pseudopolyOuterTriangle(
     const VertInd ia,
     const VertInd ib) const
 {
-    const std::vector<TriInd>& aTris = vertTris[ia];
-    const std::vector<TriInd>& bTris = vertTris[ib];
-    typedef std::vector<TriInd>::const_iterator TriIndCit;
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    // pseudo-polygon's vertices are attached to outer triangles
+    const TriInd iT = vertTris[ia];
+    if(iT != noNeighbor)
+    {
+        const VerticesArr3& vv = triangles[iT].vertices;
+        if(std::find(vv.begin(), vv.end(), ib) != vv.end())
+            return iT;
+    }
+    const Edge e(ia, ib);
+    typedef std::vector<std::pair<Edge, TriInd> >::const_iterator Cit;
+    for(Cit it = m_extraOuterTris.begin(); it != m_extraOuterTris.end(); ++it)
+        if(it->first == e)
+            return it->second;
+    return noNeighbor;
+#else
+    const AdjacentTriangles& aTris = vertTris[ia];
+    const AdjacentTriangles& bTris = vertTris[ib];
+    typedef typename AdjacentTriangles::const_iterator TriIndCit;
     for(TriIndCit it = aTris.begin(); it != aTris.end(); ++it)
         if(std::find(bTris.begin(), bTris.end(), *it) != bTris.end())
             return *it;
     return noNeighbor;
+#endif
 }
 
-template <typename T, typename TNearPointLocator>
-void Triangulation<T, TNearPointLocator>::insertVertices(
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVertices(
     const std::vector<V2d<T> >& newVertices)
 {
     return insertVertices(
         newVertices.begin(), newVertices.end(), getX_V2d<T>, getY_V2d<T>);
 }
 
-template <typename T, typename TNearPointLocator>
-bool Triangulation<T, TNearPointLocator>::isFinalized() const
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::insertVerticesParallel(
+    const std::vector<V2d<T> >& newVertices,
+    const std::size_t nThreads)
+{
+    return insertVerticesParallel(
+        newVertices.begin(),
+        newVertices.end(),
+        getX_V2d<T>,
+        getY_V2d<T>,
+        nThreads);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+bool Triangulation<T, TNearPointLocator, TAllocator>::isFinalized() const
 {
     return vertTris.empty() && !vertices.empty();
 }
 
-template <typename T, typename TNearPointLocator>
-unordered_map<TriInd, LayerDepth>
-Triangulation<T, TNearPointLocator>::peelLayer(
-    std::stack<TriInd> seeds,
+template <typename T, typename TNearPointLocator, typename TAllocator>
+SuperGeometryType::Enum
+Triangulation<T, TNearPointLocator, TAllocator>::superGeometryType() const
+{
+    return m_superGeomType;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::size_t
+Triangulation<T, TNearPointLocator, TAllocator>::superGeometryVertexCount() const
+{
+    // finalizing removes super-triangle's vertices
+    if(isFinalized() && m_superGeomType == SuperGeometryType::SuperTriangle)
+        return 0;
+    return m_nTargetVerts;
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::reset()
+{
+#ifndef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    m_vertTrisPool.reserve(m_vertTrisPool.size() + vertTris.size());
+    typedef typename Adjacency::iterator It;
+    for(It it = vertTris.begin(); it != vertTris.end(); ++it)
+    {
+        m_vertTrisPool.push_back(AdjacentTriangles());
+        m_vertTrisPool.back().swap(*it);
+        m_vertTrisPool.back().clear();
+    }
+#endif
+    vertices.clear();
+    triangles.clear();
+    fixedEdges.clear();
+    vertTris.clear();
+    overlapCount.clear();
+    pieceToOriginals.clear();
+#ifdef CDT_ENABLE_STATS
+    stats = TriangulationStats();
+#endif
+    m_dummyTris.clear();
+    m_nTargetVerts = detail::defaults::nTargetVerts;
+    m_superGeomType = detail::defaults::superGeomType;
+    m_isConvex = false;
+#ifdef CDT_USE_COMPACT_VERTEX_ADJACENCY
+    m_extraOuterTris.clear();
+#endif
+    m_walkRandState = detail::walkRandSeed;
+    m_randGen.seed(detail::shuffleSeed);
+    // last: custom locators may throw, all other state is reset by then
+    m_nearPtLocator.initialize(vertices);
+}
+
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::peelLayer(
     const LayerDepth layerDepth,
-    std::vector<LayerDepth>& triDepths) const
+    std::vector<LayerDepth>& triDepths,
+    TraversalWorkspace& workspace) const
 {
-    unordered_map<TriInd, LayerDepth> behindBoundary;
+    std::vector<TriInd>& seeds = workspace.stack;
+    std::vector<std::pair<LayerDepth, TriInd> >& deeper =
+        workspace.deeperSeeds;
+    const std::greater<std::pair<LayerDepth, TriInd> > isDeeper;
     while(!seeds.empty())
     {
-        const TriInd iT = seeds.top();
-        seeds.pop();
+        const TriInd iT = seeds.back();
+        seeds.pop_back();
         triDepths[iT] = layerDepth;
-        behindBoundary.erase(iT);
         const Triangle& t = triangles[iT];
         for(Index i(0); i < Index(3); ++i)
         {
@@ -1621,44 +3703,234 @@ Triangulation<T, TNearPointLocator>::peelLayer(
                 const LayerDepth triDepth = cit == overlapCount.end()
                                                 ? layerDepth + 1
                                                 : layerDepth + cit->second + 1;
-                behindBoundary[iN] = triDepth;
+                deeper.push_back(std::make_pair(triDepth, iN));
+                std::push_heap(deeper.begin(), deeper.end(), isDeeper);
                 continue;
             }
-            seeds.push(iN);
+            seeds.push_back(iN);
         }
     }
-    return behindBoundary;
 }
 
-template <typename T, typename TNearPointLocator>
+template <typename T, typename TNearPointLocator, typename TAllocator>
 std::vector<LayerDepth>
-Triangulation<T, TNearPointLocator>::calculateTriangleDepths() const
+Triangulation<T, TNearPointLocator, TAllocator>::calculateTriangleDepths() const
 {
-    std::vector<LayerDepth> triDepths(
-        triangles.size(), std::numeric_limits<LayerDepth>::max());
-    std::stack<TriInd> seeds(TriDeque(1, vertTris[0].front()));
-    LayerDepth layerDepth = 0;
-    LayerDepth deepestSeedDepth = 0;
+    std::vector<LayerDepth> triDepths;
+    TraversalWorkspace workspace;
+    calculateTriangleDepths(triDepths, workspace);
+    return triDepths;
+}
 
-    unordered_map<LayerDepth, TriIndUSet> seedsByDepth;
-    do
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::calculateTriangleDepths(
+    std::vector<LayerDepth>& triDepths,
+    TraversalWorkspace& workspace) const
+{
+    triDepths.assign(triangles.size(), std::numeric_limits<LayerDepth>::max());
+    std::vector<TriInd>& seeds = workspace.stack;
+    std::vector<std::pair<LayerDepth, TriInd> >& deeper =
+        workspace.deeperSeeds;
+    const std::greater<std::pair<LayerDepth, TriInd> > isDeeper;
+    seeds.clear();
+    deeper.assign(1, std::make_pair(LayerDepth(0), adjacentTriangle(0)));
+    // peel layers from the shallowest: a triangle seeded at several depths
+    // gets the smallest one
+    while(!deeper.empty())
     {
-        const unordered_map<TriInd, LayerDepth>& newSeeds =
-            peelLayer(seeds, layerDepth, triDepths);
+        const LayerDepth layerDepth = deeper.front().first;
+        while(!deeper.empty() && deeper.front().first == layerDepth)
+        {
+            const TriInd iT = deeper.front().second;
+            std::pop_heap(deeper.begin(), deeper.end(), isDeeper);
+            deeper.pop_back();
+            if(triDepths[iT] > layerDepth)
+                seeds.push_back(iT);
+        }
+        peelLayer(layerDepth, triDepths, workspace);
+    }
+}
+
+namespace detail
+{
+
+/// Find root of triangle's union-find tree halving the path on the way
+inline TriInd findRoot(std::vector<TriInd>& parent, TriInd iT)
+{
+    while(parent[iT] != iT)
+    {
+        parent[iT] = parent[parent[iT]];
+        iT = parent[iT];
+    }
+    return iT;
+}
+
+/**
+ * Join union-find trees of two triangles
+ * @note larger root is attached to the smaller one: parent of a triangle
+ * never has a larger index than the triangle itself
+ */
+inline void uniteRoots(std::vector<TriInd>& parent, TriInd a, TriInd b)
+{
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if(a < b)
+        parent[b] = a;
+    else if(b < a)
+        parent[a] = b;
+}
+
+} // namespace detail
 
-        seedsByDepth.erase(layerDepth);
-        typedef unordered_map<TriInd, LayerDepth>::const_iterator Iter;
-        for(Iter it = newSeeds.begin(); it != newSeeds.end(); ++it)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+void Triangulation<T, TNearPointLocator, TAllocator>::linkTrianglesInRange(
+    const TriInd first,
+    const TriInd last,
+    std::vector<TriInd>& parent,
+    std::vector<DepthLink>& links) const
+{
+    for(TriInd iT = first; iT < last; ++iT)
+    {
+        const Triangle& t = triangles[iT];
+        for(Index i(0); i < Index(3); ++i)
         {
-            deepestSeedDepth = std::max(deepestSeedDepth, it->second);
-            seedsByDepth[it->second].insert(it->first);
+            const TriInd iN = t.neighbors[opoNbr(i)];
+            // each edge is visited from its smaller triangle
+            if(iN == noNeighbor || iN < iT)
+                continue;
+            // dummy triangles keep one-sided links to their old neighbors
+            const NeighborsArr3& nn = triangles[iN].neighbors;
+            if(std::find(nn.begin(), nn.end(), iT) == nn.end())
+                continue;
+            const Edge opEdge(t.vertices[ccw(i)], t.vertices[cw(i)]);
+            if(fixedEdges.count(opEdge))
+            {
+                const unordered_map<Edge, LayerDepth>::const_iterator cit =
+                    overlapCount.find(opEdge);
+                const LayerDepth step =
+                    cit == overlapCount.end() ? 1 : cit->second + 1;
+                links.push_back(make_tuple(iT, iN, step));
+            }
+            else if(iN < last)
+                detail::uniteRoots(parent, iT, iN);
+            else
+                links.push_back(make_tuple(iT, iN, LayerDepth(0)));
         }
-        const TriIndUSet& nextLayerSeeds = seedsByDepth[layerDepth + 1];
-        seeds = std::stack<TriInd>(
-            TriDeque(nextLayerSeeds.begin(), nextLayerSeeds.end()));
-        ++layerDepth;
-    } while(!seeds.empty() || deepestSeedDepth > layerDepth);
+    }
+}
 
+template <typename T, typename TNearPointLocator, typename TAllocator>
+std::vector<LayerDepth>
+Triangulation<T, TNearPointLocator, TAllocator>::calculateTriangleDepthsParallel(
+    std::size_t nThreads) const
+{
+    const std::size_t n = triangles.size();
+    std::vector<LayerDepth> triDepths(
+        n, std::numeric_limits<LayerDepth>::max());
+    if(n == 0)
+        return triDepths;
+    nThreads = std::max(std::min(nThreads, n), std::size_t(1));
+    std::vector<TriInd> parent(n);
+    for(TriInd iT(0); iT < TriInd(n); ++iT)
+        parent[iT] = iT;
+    // join triangles into regions chunk by chunk
+    std::vector<std::vector<DepthLink> > chunkLinks(nThreads);
+#ifdef CDT_CXX11_IS_SUPPORTED
+    detail::ThreadGroup threads(nThreads - 1);
+    for(std::size_t k = 1; k < nThreads; ++k)
+    {
+        threads.run(std::bind(
+            &Triangulation::linkTrianglesInRange,
+            this,
+            TriInd(n * k / nThreads),
+            TriInd(n * (k + 1) / nThreads),
+            std::ref(parent),
+            std::ref(chunkLinks[k])));
+    }
+    linkTrianglesInRange(
+        TriInd(0), TriInd(n / nThreads), parent, chunkLinks[0]);
+    threads.join();
+#else
+    for(std::size_t k = 0; k < nThreads; ++k)
+    {
+        linkTrianglesInRange(
+            TriInd(n * k / nThreads),
+            TriInd(n * (k + 1) / nThreads),
+            parent,
+            chunkLinks[k]);
+    }
+#endif
+    // join regions across chunks, keep links across constraint edges
+    std::vector<DepthLink> links;
+    typedef typename std::vector<DepthLink>::const_iterator LinkCit;
+    for(std::size_t k = 0; k < nThreads; ++k)
+    {
+        const std::vector<DepthLink>& cl = chunkLinks[k];
+        for(LinkCit it = cl.begin(); it != cl.end(); ++it)
+        {
+            if(get<2>(*it) == LayerDepth(0))
+                detail::uniteRoots(parent, get<0>(*it), get<1>(*it));
+            else
+                links.push_back(*it);
+        }
+        std::vector<DepthLink>().swap(chunkLinks[k]);
+    }
+    // parents never have larger indices: one pass makes all trees flat
+    for(TriInd iT(0); iT < TriInd(n); ++iT)
+        parent[iT] = parent[parent[iT]];
+    // graph of regions in compressed sparse row layout
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for(LinkCit it = links.begin(); it != links.end(); ++it)
+    {
+        const TriInd r1 = parent[get<0>(*it)], r2 = parent[get<1>(*it)];
+        if(r1 == r2)
+            continue;
+        ++offsets[r1 + 1];
+        ++offsets[r2 + 1];
+    }
+    for(std::size_t i = 0; i < n; ++i)
+        offsets[i + 1] += offsets[i];
+    std::vector<std::pair<TriInd, LayerDepth> > adjacent(offsets[n]);
+    {
+        std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+        for(LinkCit it = links.begin(); it != links.end(); ++it)
+        {
+            const TriInd r1 = parent[get<0>(*it)], r2 = parent[get<1>(*it)];
+            if(r1 == r2)
+                continue;
+            adjacent[pos[r1]++] = std::make_pair(r2, get<2>(*it));
+            adjacent[pos[r2]++] = std::make_pair(r1, get<2>(*it));
+        }
+    }
+    // shortest paths from the region touching super-triangle's vertex
+    std::vector<LayerDepth> regionDepths(
+        n, std::numeric_limits<LayerDepth>::max());
+    const TriInd rStart = parent[adjacentTriangle(0)];
+    regionDepths[rStart] = LayerDepth(0);
+    std::vector<std::pair<LayerDepth, TriInd> > deeper(
+        1, std::make_pair(LayerDepth(0), rStart));
+    const std::greater<std::pair<LayerDepth, TriInd> > isDeeper;
+    while(!deeper.empty())
+    {
+        const LayerDepth depth = deeper.front().first;
+        const TriInd r = deeper.front().second;
+        std::pop_heap(deeper.begin(), deeper.end(), isDeeper);
+        deeper.pop_back();
+        if(depth > regionDepths[r])
+            continue;
+        for(std::size_t j = offsets[r]; j != offsets[r + 1]; ++j)
+        {
+            const TriInd rN = adjacent[j].first;
+            const LayerDepth depthN = depth + adjacent[j].second;
+            if(depthN >= regionDepths[rN])
+                continue;
+            regionDepths[rN] = depthN;
+            deeper.push_back(std::make_pair(depthN, rN));
+            std::push_heap(deeper.begin(), deeper.end(), isDeeper);
+        }
+    }
+    for(TriInd iT(0); iT < TriInd(n); ++iT)
+        triDepths[iT] = regionDepths[parent[iT]];
     return triDepths;
 }
 
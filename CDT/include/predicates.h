@@ -172,6 +172,11 @@ namespace  predicates {
 #include <algorithm>//transform, copy_n, merge
 #include <functional>//negate
 
+// hook called when an adaptive predicate leaves the fast floating-point path
+#ifndef PREDICATES_ON_SLOW_PATH
+	#define PREDICATES_ON_SLOW_PATH()
+#endif
+
 // a macro based static assert for pre c++11
 #define PREDICATES_PORTABLE_STATIC_ASSERT(condition, message) typedef char message[(condition) ? 1 : -1]
 
@@ -624,6 +629,7 @@ namespace detail {
 			const T detsum = std::abs(detleft + detright);
 			T errbound = Constants<T>::ccwerrboundA * detsum;
 			if(std::abs(det) >= std::abs(errbound)) return det;
+			PREDICATES_ON_SLOW_PATH();
 
 			const detail::Expansion<T, 4> B = detail::ExpansionBase<T>::TwoTwoDiff(acx, bcy, acy, bcx);
 			det = B.estimate();
@@ -670,6 +676,7 @@ namespace detail {
 			                  + (std::abs(adxbdy) + std::abs(bdxady)) * clift;
 			T errbound = Constants<T>::iccerrboundA * permanent;
 			if(std::abs(det) >= std::abs(errbound)) return det;
+			PREDICATES_ON_SLOW_PATH();
 
 			const detail::Expansion<T, 4> bc = detail::ExpansionBase<T>::TwoTwoDiff(bdx, cdy, cdx, bdy);
 			const detail::Expansion<T, 4> ca = detail::ExpansionBase<T>::TwoTwoDiff(cdx, ady, adx, cdy);
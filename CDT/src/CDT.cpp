@@ -31,6 +31,15 @@ template struct CDT_EXPORT Box2d<double>;
 template class CDT_EXPORT Triangulation<float>;
 template class CDT_EXPORT Triangulation<double>;
 
+template class CDT_EXPORT Triangulation<float, LocatorBucketGrid<float> >;
+template class CDT_EXPORT Triangulation<double, LocatorBucketGrid<double> >;
+
+template class CDT_EXPORT Triangulation<float, LocatorLastInserted<float> >;
+template class CDT_EXPORT Triangulation<double, LocatorLastInserted<double> >;
+
+template class CDT_EXPORT Triangulation<float, LocatorRegularGrid<float> >;
+template class CDT_EXPORT Triangulation<double, LocatorRegularGrid<double> >;
+
 template CDT_EXPORT Box2d<float>
 envelopBox<float>(const std::vector<V2d<float> >&);
 template CDT_EXPORT Box2d<double>
@@ -48,6 +57,50 @@ template CDT_EXPORT DuplicatesInfo RemoveDuplicatesAndRemapEdges<double>(
     std::vector<V2d<double> >&,
     std::vector<Edge>&);
 
+template CDT_EXPORT DuplicatesInfo
+RemoveDuplicatesAndRemapEdgesParallel<float>(
+    std::vector<V2d<float> >&,
+    std::vector<Edge>&,
+    std::size_t);
+template CDT_EXPORT DuplicatesInfo
+RemoveDuplicatesAndRemapEdgesParallel<double>(
+    std::vector<V2d<double> >&,
+    std::vector<Edge>&,
+    std::size_t);
+
+template CDT_EXPORT void orient2D<float>(
+    const V2d<float>&,
+    const V2d<float>*,
+    const V2d<float>*,
+    std::size_t,
+    float*);
+template CDT_EXPORT void orient2D<double>(
+    const V2d<double>&,
+    const V2d<double>*,
+    const V2d<double>*,
+    std::size_t,
+    double*);
+
+template CDT_EXPORT void isInCircumcircle<float>(
+    const V2d<float>&,
+    const V2d<float>*,
+    const V2d<float>*,
+    const V2d<float>*,
+    std::size_t,
+    bool*);
+template CDT_EXPORT void isInCircumcircle<double>(
+    const V2d<double>&,
+    const V2d<double>*,
+    const V2d<double>*,
+    const V2d<double>*,
+    std::size_t,
+    bool*);
+
+template CDT_EXPORT float
+distanceSquared<float>(const V2d<float>&, const V2d<float>&);
+template CDT_EXPORT double
+distanceSquared<double>(const V2d<double>&, const V2d<double>&);
+
 template CDT_EXPORT bool
 verifyTopology<float>(const CDT::Triangulation<float>&);
 template CDT_EXPORT bool
@@ -69,6 +122,22 @@ template CDT_EXPORT void initializeWithRegularGrid<double>(
     std::size_t,
     std::size_t,
     Triangulation<double>&);
+template CDT_EXPORT void initializeWithRegularGrid<float>(
+    float,
+    float,
+    float,
+    float,
+    std::size_t,
+    std::size_t,
+    Triangulation<float, LocatorRegularGrid<float> >&);
+template CDT_EXPORT void initializeWithRegularGrid<double>(
+    double,
+    double,
+    double,
+    double,
+    std::size_t,
+    std::size_t,
+    Triangulation<double, LocatorRegularGrid<double> >&);
 
 } // namespace CDT
 
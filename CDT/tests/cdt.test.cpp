@@ -1,4 +1,7 @@
 #include <CDT.h>
+#include <InitializeWithGrid.h>
+#include <Serialization.h>
+#include <TiledTriangulation.h>
 #include <VerifyTopology.h>
 
 #include <catch2/benchmark/catch_benchmark.hpp>
@@ -8,10 +11,14 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 using namespace CDT;
 
@@ -48,8 +55,9 @@ bool operator<(const Triangle& lhs, const Triangle& rhs)
 namespace
 {
 
-template <typename T, typename TNearPointLocator>
-EdgeUSet extractAllEdges(const CDT::Triangulation<T, TNearPointLocator>& cdt)
+template <typename T, typename TNearPointLocator, typename TAllocator>
+EdgeUSet extractAllEdges(
+    const CDT::Triangulation<T, TNearPointLocator, TAllocator>& cdt)
 {
     EdgeUSet out;
     for(const auto& t : cdt.triangles)
@@ -464,6 +472,8 @@ std::string to_string(const VertexInsertionOrder::Enum& vio)
         return "as-provided";
     case VertexInsertionOrder::Randomized:
         return "randomized";
+    case VertexInsertionOrder::BRIO:
+        return "brio";
     }
     ENHANCED_THROW(std::runtime_error, "Reached unreachable");
 }
@@ -527,7 +537,9 @@ TEMPLATE_LIST_TEST_CASE(
             : "";
 
     const auto order = GENERATE(
-        VertexInsertionOrder::AsProvided, VertexInsertionOrder::Randomized);
+        VertexInsertionOrder::AsProvided,
+        VertexInsertionOrder::Randomized,
+        VertexInsertionOrder::BRIO);
     const auto intersectingEdgesStrategy = GENERATE(
         IntersectingConstraintEdges::Ignore,
         IntersectingConstraintEdges::Resolve);
@@ -689,4 +701,1534 @@ TEMPLATE_LIST_TEST_CASE("Ground truth tests: crossing edges", "", CoordTypes)
         else
             REQUIRE(topologyString(cdt) == topologyString(outFile));
     }
-}
\ No newline at end of file
+}
+TEMPLATE_LIST_TEST_CASE("Inserting edges in spatial order", "", CoordTypes)
+{
+    const auto inputFile = GENERATE(
+        as<std::string>{},
+        "Capital A.txt",
+        "cdt.txt",
+        "guitar no box.txt",
+        "kidney.txt",
+        "overlapping constraints.txt");
+    INFO("Input file is '" + inputFile + "'");
+    auto [vv, ee] = readInputFromFile<TestType>("inputs/" + inputFile);
+    RemoveDuplicatesAndRemapEdges(vv, ee);
+
+    auto expected = Triangulation<TestType>();
+    expected.insertVertices(vv);
+    expected.insertEdges(ee);
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertEdgesBatch(ee);
+    REQUIRE(verifyTopology(cdt));
+    REQUIRE(cdt.fixedEdges == expected.fixedEdges);
+    REQUIRE(cdt.overlapCount == expected.overlapCount);
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+    cdt.eraseOuterTrianglesAndHoles();
+    expected.eraseOuterTrianglesAndHoles();
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+
+    auto conforming = Triangulation<TestType>();
+    conforming.insertVertices(vv);
+    conforming.conformToEdges(ee);
+    auto conformingBatch = Triangulation<TestType>();
+    conformingBatch.insertVertices(vv);
+    conformingBatch.conformToEdgesBatch(ee);
+    REQUIRE(verifyTopology(conformingBatch));
+    REQUIRE(conformingBatch.fixedEdges.size() == conforming.fixedEdges.size());
+    auto sortedVertices = [](Vertices<TestType> vv) {
+        std::sort(vv.begin(), vv.end(), [](const auto& a, const auto& b) {
+            return a.x != b.x ? a.x < b.x : a.y < b.y;
+        });
+        return vv;
+    };
+    REQUIRE(
+        sortedVertices(conformingBatch.vertices) ==
+        sortedVertices(conforming.vertices));
+}
+
+TEMPLATE_LIST_TEST_CASE("Limiting Steiner points", "", CoordTypes)
+{
+    auto [vv, ee] = readInputFromFile<TestType>("inputs/guitar no box.txt");
+    RemoveDuplicatesAndRemapEdges(vv, ee);
+    auto cdt = Triangulation<TestType>();
+    REQUIRE(cdt.maxSteinerPoints() == std::numeric_limits<std::size_t>::max());
+    cdt.insertVertices(vv);
+    cdt.conformToEdges(ee);
+    const std::size_t nAdded = cdt.vertices.size() - vv.size() - 3;
+    REQUIRE(nAdded > 0);
+
+    auto limited = Triangulation<TestType>();
+    limited.setMaxSteinerPoints(nAdded);
+    limited.insertVertices(vv);
+    limited.conformToEdges(ee);
+    REQUIRE(limited.vertices == cdt.vertices);
+    REQUIRE(limited.fixedEdges == cdt.fixedEdges);
+
+    auto tooLimited = Triangulation<TestType>();
+    tooLimited.setMaxSteinerPoints(nAdded - 1);
+    tooLimited.insertVertices(vv);
+    REQUIRE_THROWS_AS(tooLimited.conformToEdges(ee), std::runtime_error);
+    REQUIRE(tooLimited.vertices.size() == cdt.vertices.size() - 1);
+    REQUIRE(verifyTopology(tooLimited));
+    // edge pieces fixed before the limit was reached are in triangulation
+    const auto edges = extractEdgesFromTriangles(tooLimited.triangles);
+    for(const auto& e : tooLimited.fixedEdges)
+        REQUIRE(edges.count(e));
+}
+
+TEMPLATE_LIST_TEST_CASE("Inserting polylines and rings", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    // concentric rings with jittered radii connected by radial polylines
+    const auto nRings = 5;
+    const auto nRingVerts = 64;
+    auto rings = std::vector<std::vector<VertInd> >(nRings);
+    for(int i = 0; i < nRings; ++i)
+    {
+        for(int j = 0; j < nRingVerts; ++j)
+        {
+            const auto r = 10. * (i + 1) + 0.1 * dist(gen);
+            const auto phi = 2 * 3.14159265358979 * j / nRingVerts;
+            rings[i].push_back(VertInd(vv.size()));
+            vv.push_back(V2d<TestType>::make(
+                TestType(r * std::cos(phi)), TestType(r * std::sin(phi))));
+        }
+    }
+    auto polylines = std::vector<std::vector<VertInd> >();
+    for(int j = 0; j < nRingVerts; j += 8)
+    {
+        polylines.push_back(std::vector<VertInd>());
+        for(int i = 0; i < nRings; ++i)
+            polylines.back().push_back(rings[i][j]);
+    }
+    for(int i = 0; i < 2000; ++i)
+    {
+        vv.push_back(V2d<TestType>::make(
+            TestType(60 * dist(gen)), TestType(60 * dist(gen))));
+    }
+    auto ee = EdgeVec{};
+    for(const auto& ring : rings)
+        for(std::size_t i = 0; i < ring.size(); ++i)
+            ee.push_back(Edge(ring[i], ring[(i + 1) % ring.size()]));
+    for(const auto& polyline : polylines)
+        for(std::size_t i = 1; i < polyline.size(); ++i)
+            ee.push_back(Edge(polyline[i - 1], polyline[i]));
+
+    auto expected = Triangulation<TestType>();
+    expected.insertVertices(vv);
+    expected.insertEdges(ee);
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertRings(rings);
+    cdt.insertPolylines(polylines);
+    REQUIRE(verifyTopology(cdt));
+    REQUIRE(cdt.fixedEdges == expected.fixedEdges);
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+    cdt.eraseOuterTrianglesAndHoles();
+    expected.eraseOuterTrianglesAndHoles();
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+}
+
+TEMPLATE_LIST_TEST_CASE("Rings with less than 3 vertices", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{
+        V2d<TestType>::make(0, 0),
+        V2d<TestType>::make(1, 0),
+        V2d<TestType>::make(0, 1)};
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    // closing edge is not inserted again: it would count as an overlap
+    cdt.insertRings({{0, 1}, {2}});
+    REQUIRE(cdt.fixedEdges == EdgeUSet{Edge(3 + 0, 3 + 1)});
+    REQUIRE(cdt.overlapCount.empty());
+    REQUIRE(verifyTopology(cdt));
+}
+
+TEMPLATE_LIST_TEST_CASE("Removing vertices", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    for(int i = 0; i < 1000; ++i)
+    {
+        vv.push_back(
+            V2d<TestType>::make(TestType(dist(gen)), TestType(dist(gen))));
+    }
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertEdges(EdgeVec{Edge(0, 1), Edge(1, 2), Edge(5, 6)});
+    auto kept = Vertices<TestType>{};
+    for(std::size_t i = 0; i < vv.size(); ++i)
+    {
+        if(i % 3 == 1)
+            cdt.removeVertex(VertInd(i));
+        else
+            kept.push_back(vv[i]);
+    }
+    REQUIRE(verifyTopology(cdt));
+    REQUIRE_THROWS(cdt.removeVertex(1));
+    // constraints ending at removed vertices are gone
+    REQUIRE(cdt.fixedEdges == EdgeUSet{Edge(3 + 5, 3 + 6)});
+    // removal gives the same triangulation as not inserting the vertices
+    const auto positionEdges = [](const Triangulation<TestType>& t) {
+        typedef std::pair<TestType, TestType> Pt;
+        auto edges = std::vector<std::pair<Pt, Pt> >();
+        for(const auto& e : extractEdgesFromTriangles(t.triangles))
+        {
+            const auto a = Pt(t.vertices[e.v1()].x, t.vertices[e.v1()].y);
+            const auto b = Pt(t.vertices[e.v2()].x, t.vertices[e.v2()].y);
+            edges.push_back(a < b ? std::make_pair(a, b) : std::make_pair(b, a));
+        }
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    };
+    auto expected = Triangulation<TestType>();
+    expected.insertVertices(kept);
+    expected.insertEdges(EdgeVec{Edge(3, 4)}); // kept vertices 5 and 6
+    auto removed = cdt;
+    removed.eraseSuperTriangle();
+    expected.eraseSuperTriangle();
+    REQUIRE(positionEdges(removed) == positionEdges(expected));
+    // removed vertices can be inserted again
+    cdt.insertVertices(Vertices<TestType>{vv[1], vv[4]});
+    REQUIRE(verifyTopology(cdt));
+    REQUIRE(cdt.vertices.size() == vv.size() + 3 + 2);
+}
+
+TEMPLATE_LIST_TEST_CASE(
+    "Removing vertices splitting constraint edges",
+    "",
+    CoordTypes)
+{
+    using V = V2d<TestType>;
+    const auto requireFixedEdgesInTriangulation =
+        [](const Triangulation<TestType>& cdt) {
+            REQUIRE(verifyTopology(cdt));
+            const auto edges = extractEdgesFromTriangles(cdt.triangles);
+            for(const auto& e : cdt.fixedEdges)
+                REQUIRE(edges.count(e));
+        };
+    SECTION("Vertex inside of a polyline")
+    {
+        auto vv = Vertices<TestType>{
+            V::make(0, 0), V::make(1, 0), V::make(2, 0), V::make(1, 1),
+            V::make(1, -1)};
+        auto cdt = Triangulation<TestType>();
+        cdt.insertVertices(vv);
+        cdt.insertPolylines({{0, 1, 2}});
+        cdt.removeVertex(1);
+        REQUIRE(cdt.fixedEdges == EdgeUSet{Edge(3 + 0, 3 + 2)});
+        REQUIRE(cdt.pieceToOriginals.empty());
+        requireFixedEdgesInTriangulation(cdt);
+    }
+    SECTION("Steiner point of conforming")
+    {
+        auto vv = Vertices<TestType>{V::make(-100, -1), V::make(100, 1)};
+        std::mt19937 gen(77);
+        std::uniform_real_distribution<double> dist(-100, 100);
+        for(int i = 0; i < 500; ++i)
+            vv.push_back(V::make(TestType(dist(gen)), TestType(dist(gen))));
+        const auto original = Edge(0, 1);
+        auto cdt = Triangulation<TestType>();
+        cdt.insertVertices(vv);
+        cdt.conformToEdges(EdgeVec{original});
+        const auto nSteiner = cdt.vertices.size() - vv.size() - 3;
+        REQUIRE(nSteiner > 1);
+        const auto originalInCdt = Edge(3 + 0, 3 + 1);
+        cdt.removeVertex(VertInd(vv.size())); // first Steiner point
+        REQUIRE(cdt.fixedEdges.size() == nSteiner);
+        for(const auto& e : cdt.fixedEdges)
+        {
+            REQUIRE(
+                cdt.pieceToOriginals.at(e) == EdgeVec{originalInCdt});
+        }
+        requireFixedEdgesInTriangulation(cdt);
+    }
+    SECTION("Intersection of constraint edges")
+    {
+        auto vv = Vertices<TestType>{
+            V::make(-1, 0), V::make(1, 0), V::make(0, -1), V::make(0, 1)};
+        auto cdt = Triangulation<TestType>(
+            VertexInsertionOrder::Randomized,
+            IntersectingConstraintEdges::Resolve,
+            TestType(0));
+        cdt.insertVertices(vv);
+        cdt.insertEdges(EdgeVec{Edge(0, 1), Edge(2, 3)});
+        REQUIRE(cdt.vertices.size() == vv.size() + 3 + 1);
+        const auto fixedEdges = cdt.fixedEdges;
+        const auto nTriangles = cdt.triangles.size();
+        REQUIRE_THROWS_AS(
+            cdt.removeVertex(VertInd(vv.size())), std::runtime_error);
+        REQUIRE(cdt.fixedEdges == fixedEdges);
+        REQUIRE(cdt.triangles.size() == nTriangles);
+        requireFixedEdgesInTriangulation(cdt);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE(
+    "Finalized copies keep triangulation editable",
+    "",
+    CoordTypes)
+{
+    // square boundary with a square hole
+    auto vv = Vertices<TestType>{
+        V2d<TestType>::make(0, 0),
+        V2d<TestType>::make(10, 0),
+        V2d<TestType>::make(10, 10),
+        V2d<TestType>::make(0, 10),
+        V2d<TestType>::make(4, 4),
+        V2d<TestType>::make(6, 4),
+        V2d<TestType>::make(6, 6),
+        V2d<TestType>::make(4, 6),
+    };
+    const auto ee = EdgeVec{
+        Edge(0, 1),
+        Edge(1, 2),
+        Edge(2, 3),
+        Edge(3, 0),
+        Edge(4, 5),
+        Edge(5, 6),
+        Edge(6, 7),
+        Edge(7, 4)};
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> dist(-2, 12);
+    auto cdt = Triangulation<TestType>();
+    // vertices inserted later are outside of the first batch's bounding box
+    const auto box = Box2d<TestType>{
+        V2d<TestType>::make(-2, -2), V2d<TestType>::make(12, 12)};
+    cdt.initializeSuperTriangle(box);
+    REQUIRE_THROWS(cdt.initializeSuperTriangle(box));
+    cdt.insertVertices(vv);
+    cdt.insertEdges(ee);
+    for(int iUpdate = 0; iUpdate < 3; ++iUpdate)
+    {
+        auto more = Vertices<TestType>{};
+        for(int i = 0; i < 100; ++i)
+        {
+            more.push_back(
+                V2d<TestType>::make(TestType(dist(gen)), TestType(dist(gen))));
+        }
+        cdt.insertVertices(more);
+        const auto nTriangles = cdt.triangles.size();
+        const auto check = [](const Triangulation<TestType>& copy,
+                              const Triangulation<TestType>& expected) {
+            REQUIRE(copy.isFinalized());
+            REQUIRE(copy.vertices == expected.vertices);
+            REQUIRE(copy.triangles.size() == expected.triangles.size());
+            REQUIRE(extractAllEdges(copy) == extractAllEdges(expected));
+            REQUIRE(copy.fixedEdges == expected.fixedEdges);
+            REQUIRE(verifyTopology(copy));
+        };
+        auto expected = cdt;
+        expected.eraseSuperTriangle();
+        check(cdt.withSuperTriangleErased(), expected);
+        expected = cdt;
+        expected.eraseOuterTriangles();
+        check(cdt.withOuterTrianglesErased(), expected);
+        expected = cdt;
+        expected.eraseOuterTrianglesAndHoles();
+        check(cdt.withOuterTrianglesAndHolesErased(), expected);
+        REQUIRE(!cdt.isFinalized());
+        REQUIRE(cdt.triangles.size() == nTriangles);
+        REQUIRE(verifyTopology(cdt));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Binary serialization", "", CoordTypes)
+{
+    const auto [vv, ee] = readInputFromFile<TestType>(
+        "inputs/issue-42-multiple-boundary-overlaps.txt");
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.conformToEdges(ee);
+    REQUIRE(!cdt.overlapCount.empty());
+    REQUIRE(!cdt.pieceToOriginals.empty());
+    const auto roundTrip = [](const Triangulation<TestType>& t) {
+        std::stringstream ss;
+        writeBinary(ss, t);
+        auto loaded = Triangulation<TestType>();
+        readBinary(ss, loaded);
+        REQUIRE(loaded.isFinalized() == t.isFinalized());
+        REQUIRE(loaded.vertices == t.vertices);
+        REQUIRE(loaded.triangles.size() == t.triangles.size());
+        REQUIRE(extractAllEdges(loaded) == extractAllEdges(t));
+        REQUIRE(loaded.fixedEdges == t.fixedEdges);
+        REQUIRE(loaded.overlapCount == t.overlapCount);
+        REQUIRE(loaded.pieceToOriginals == t.pieceToOriginals);
+        return loaded;
+    };
+    SECTION("Loaded triangulation can be edited")
+    {
+        auto loaded = roundTrip(cdt);
+        REQUIRE(verifyTopology(loaded));
+        const auto more = Vertices<TestType>{
+            V2d<TestType>::make(TestType(0.5), TestType(0.25)),
+            V2d<TestType>::make(TestType(1.5), TestType(0.75))};
+        cdt.insertVertices(more);
+        loaded.insertVertices(more);
+        REQUIRE(verifyTopology(loaded));
+        REQUIRE(extractAllEdges(loaded) == extractAllEdges(cdt));
+    }
+    SECTION("Numbers of split edges' originals do not add up")
+    {
+        std::stringstream ss;
+        writeBinary(ss, cdt);
+        auto str = ss.str();
+        detail::BinaryHeader h;
+        std::memcpy(&h, str.data(), sizeof(h));
+        REQUIRE(h.nOriginals > 1);
+        // fewer originals than pieces refer to: reading them would overrun
+        for(const auto n : {h.nOriginals - 1, 0ull})
+        {
+            auto corrupted = str;
+            std::memcpy(
+                &corrupted[offsetof(detail::BinaryHeader, nOriginals)],
+                &n,
+                sizeof(n));
+            std::istringstream in(corrupted);
+            auto loaded = Triangulation<TestType>();
+            REQUIRE_THROWS_AS(readBinary(in, loaded), std::runtime_error);
+        }
+    }
+    SECTION("Finalized triangulation and in-place view")
+    {
+        cdt.eraseOuterTrianglesAndHoles();
+        roundTrip(cdt);
+        std::stringstream ss;
+        writeBinary(ss, cdt);
+        const auto str = ss.str();
+        // 8-byte aligned buffer, e.g., memory-mapped file
+        auto buf = std::vector<unsigned long long>(str.size() / 8);
+        REQUIRE(buf.size() * 8 == str.size());
+        std::memcpy(buf.data(), str.data(), str.size());
+        const auto view = readBinaryView<TestType>(buf.data(), str.size());
+        REQUIRE(view.nVertices == cdt.vertices.size());
+        REQUIRE(view.nTriangles == cdt.triangles.size());
+        REQUIRE(view.nFixedEdges == cdt.fixedEdges.size());
+        for(std::size_t i = 0; i < view.nTriangles; ++i)
+        {
+            REQUIRE(view.triangles[i].vertices == cdt.triangles[i].vertices);
+            REQUIRE(view.triangles[i].neighbors == cdt.triangles[i].neighbors);
+        }
+        REQUIRE(view.vertices[view.nVertices - 1] == cdt.vertices.back());
+        REQUIRE_THROWS(readBinaryView<TestType>(buf.data(), str.size() - 8));
+        // corrupted number of vertices: its size in bytes would overflow
+        buf[offsetof(detail::BinaryHeader, nVertices) / 8] = 1ull << 62;
+        REQUIRE_THROWS(readBinaryView<TestType>(buf.data(), str.size()));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("KD-tree bulk-load", "", CoordTypes)
+{
+    auto points = Vertices<TestType>{};
+    // grid with many coinciding coordinates and duplicate points
+    for(int i = 0; i < 20; ++i)
+    {
+        for(int j = 0; j < 20; ++j)
+        {
+            const auto x = TestType(i % 5 == 0 ? 0 : i);
+            points.push_back(V2d<TestType>::make(x, TestType(j) / 2));
+        }
+    }
+    points.push_back(points[7]);
+    points.push_back(points[7]);
+    KDTree::KDTree<TestType, 4, 32, 32> kdTree;
+    kdTree.bulkLoad(points);
+    // points inserted incrementally after bulk-loading, some outside the box
+    for(int i = 0; i < 50; ++i)
+    {
+        points.push_back(V2d<TestType>::make(
+            TestType(30 + i % 7), TestType(-20 + i / 7)));
+        kdTree.insert(VertInd(points.size() - 1), points);
+    }
+    for(const auto& p : points)
+    {
+        const auto nearest = kdTree.nearest(p, points);
+        REQUIRE(nearest.first.x == p.x);
+        REQUIRE(nearest.first.y == p.y);
+        REQUIRE(points[nearest.second].x == p.x);
+        REQUIRE(points[nearest.second].y == p.y);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Finding duplicates in parallel", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 150);
+    for(int i = 0; i < 20000; ++i)
+    {
+        const int x = dist(gen);
+        vv.push_back(V2d<TestType>::make(TestType(x), TestType(dist(gen))));
+    }
+    auto ee = EdgeVec{};
+    for(VertInd i = 0; i + 1 < VertInd(vv.size()); i += 2)
+        ee.push_back(Edge(i, i + 1));
+    // reference: look-up first occurrences of positions in a hash map
+    auto expected = DuplicatesInfo{};
+    std::unordered_map<V2d<TestType>, std::size_t> posToIndex;
+    for(std::size_t i = 0; i < vv.size(); ++i)
+    {
+        const auto inserted = posToIndex.insert({vv[i], posToIndex.size()});
+        expected.mapping.push_back(inserted.first->second);
+        if(!inserted.second)
+            expected.duplicates.push_back(i);
+    }
+    REQUIRE(expected.duplicates.size() > vv.size() / 4);
+    const DuplicatesInfo serial = FindDuplicates<TestType>(
+        vv.begin(), vv.end(), getX_V2d<TestType>, getY_V2d<TestType>);
+    REQUIRE(serial.mapping == expected.mapping);
+    REQUIRE(serial.duplicates == expected.duplicates);
+    auto expectedEdges = ee;
+    RemapEdges(expectedEdges, expected.mapping);
+
+    const auto nThreads = GENERATE(as<std::size_t>{}, 1, 3, 8);
+    const DuplicatesInfo di =
+        RemoveDuplicatesAndRemapEdgesParallel(vv, ee, nThreads);
+    REQUIRE(di.mapping == expected.mapping);
+    REQUIRE(di.duplicates == expected.duplicates);
+    REQUIRE(ee == expectedEdges);
+    REQUIRE(vv.size() + di.duplicates.size() == di.mapping.size());
+    REQUIRE(FindDuplicates<TestType>(
+                vv.begin(), vv.end(), getX_V2d<TestType>, getY_V2d<TestType>)
+                .duplicates.empty());
+}
+
+TEMPLATE_LIST_TEST_CASE("Batched predicates match scalar", "", CoordTypes)
+{
+    using V = V2d<TestType>;
+    auto pts = Vertices<TestType>{};
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-1, 1);
+    for(int i = 0; i < 150; ++i)
+    {
+        const double x = dist(gen);
+        pts.push_back(V::make(TestType(x), TestType(dist(gen))));
+    }
+    // degenerate: collinear and co-circular points, points near the line
+    const TestType c[] = {-5, -4, -3, 0, 3, 4, 5};
+    for(const auto x : c)
+        for(const auto y : c)
+            if(x * x + y * y == 25 || x == y)
+                pts.push_back(V::make(x, y));
+    const TestType tiny = std::numeric_limits<TestType>::epsilon();
+    pts.push_back(V::make(TestType(1) + tiny, TestType(1)));
+    pts.push_back(V::make(TestType(2), TestType(2) - tiny));
+    const auto n = pts.size();
+    auto v1 = Vertices<TestType>{}, v2 = v1, v3 = v1;
+    for(std::size_t i = 0; i < n * 3; ++i)
+    {
+        v1.push_back(pts[i % n]);
+        v2.push_back(pts[(i * 7 + 1) % n]);
+        v3.push_back(pts[(i * 13 + 2) % n]);
+    }
+    std::vector<TestType> orientations(v1.size());
+    std::unique_ptr<bool[]> inCircle(new bool[v1.size()]);
+    for(const auto& p : pts)
+    {
+        orient2D(p, v1.data(), v2.data(), v1.size(), orientations.data());
+        isInCircumcircle(
+            p, v1.data(), v2.data(), v3.data(), v1.size(), inCircle.get());
+        for(std::size_t i = 0; i < v1.size(); ++i)
+        {
+            REQUIRE(orientations[i] == orient2D(p, v1[i], v2[i]));
+            REQUIRE(inCircle[i] == isInCircumcircle(p, v1[i], v2[i], v3[i]));
+        }
+    }
+    // exact results for degenerate inputs
+    const V o = V::make(0, 0);
+    REQUIRE(orient2D(V::make(5, 5), o, V::make(3, 3)) == TestType(0));
+    REQUIRE(orient2D(V::make(2, 2 - tiny * 2), o, V::make(1, 1)) < 0);
+    REQUIRE(orient2D(V::make(1 + tiny, 1), o, V::make(3, 3)) < 0);
+    const V a = V::make(5, 0), b = V::make(0, 5), d = V::make(-3, 4);
+    REQUIRE_FALSE(isInCircumcircle(V::make(-4, -3), a, b, d));
+    REQUIRE(isInCircumcircle(V::make(-4 + tiny * 4, -3), a, b, d));
+}
+
+namespace
+{
+
+// triangles without super-triangle vertices: rotated to start with the
+// smallest vertex index and sorted
+std::vector<VerticesArr3> sortedTriangles(const TriangleVec& triangles)
+{
+    std::vector<VerticesArr3> out;
+    for(const auto& t : triangles)
+    {
+        auto vv = t.vertices;
+        if(*std::min_element(vv.begin(), vv.end()) < 3)
+            continue;
+        std::rotate(
+            vv.begin(), std::min_element(vv.begin(), vv.end()), vv.end());
+        out.push_back(vv);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+} // namespace
+
+TEMPLATE_LIST_TEST_CASE(
+    "Inserting vertices from coordinate buffers",
+    "",
+    CoordTypes)
+{
+    auto xs = std::vector<TestType>{};
+    auto ys = std::vector<TestType>{};
+    auto xys = std::vector<TestType>{}; // interleaved coordinates
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    for(int i = 0; i < 1000; ++i)
+    {
+        xs.push_back(TestType(dist(gen)));
+        ys.push_back(TestType(dist(gen)));
+        xys.push_back(xs.back());
+        xys.push_back(ys.back());
+        vv.push_back(V2d<TestType>::make(xs.back(), ys.back()));
+    }
+    auto expected = Triangulation<TestType>();
+    expected.insertVertices(vv);
+    // iterate over x-buffer, y is at the same offset
+    const auto* const pxs = xs.data();
+    const auto* const pys = ys.data();
+    auto columns = Triangulation<TestType>();
+    columns.insertVertices(
+        xs.begin(),
+        xs.end(),
+        [](const TestType& x) { return x; },
+        [pxs, pys](const TestType& x) { return pys[&x - pxs]; });
+    REQUIRE(columns.vertices == expected.vertices);
+    REQUIRE(columns.triangles.size() == expected.triangles.size());
+    REQUIRE(extractAllEdges(columns) == extractAllEdges(expected));
+    // interleaved coordinates: iterate over x-coordinates with stride 2
+    auto interleaved = Triangulation<TestType>();
+    auto xIndices = std::vector<std::size_t>(xs.size());
+    for(std::size_t i = 0; i < xIndices.size(); ++i)
+        xIndices[i] = 2 * i;
+    interleaved.insertVertices(
+        xIndices.begin(),
+        xIndices.end(),
+        [&xys](const std::size_t i) { return xys[i]; },
+        [&xys](const std::size_t i) { return xys[i + 1]; });
+    REQUIRE(interleaved.vertices == expected.vertices);
+    REQUIRE(extractAllEdges(interleaved) == extractAllEdges(expected));
+}
+
+TEMPLATE_LIST_TEST_CASE("Tiled triangulation", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    for(int i = 0; i < 5000; ++i)
+    {
+        const auto x = TestType(dist(gen));
+        vv.push_back(V2d<TestType>::make(x, TestType(dist(gen))));
+    }
+    std::sort(vv.begin(), vv.end(), [](const auto& a, const auto& b) {
+        return a.x < b.x;
+    });
+    const auto box = envelopBox(vv);
+    auto expected = Triangulation<TestType>();
+    expected.initializeSuperTriangle(box);
+    expected.insertVertices(vv);
+
+    const std::size_t nTiles = 10;
+    const std::size_t tileSize = vv.size() / nTiles;
+    auto tiled = TiledTriangulation<TestType>(box);
+    auto triangles = std::vector<VerticesArr3>{};
+    std::size_t maxActive = 0;
+    for(std::size_t i = 0; i < vv.size(); i += tileSize)
+    {
+        const auto last = std::min(i + tileSize, vv.size());
+        const auto tile = Vertices<TestType>(vv.begin() + i, vv.begin() + last);
+        const auto nextMinX = last < vv.size()
+                                  ? vv[last].x
+                                  : std::numeric_limits<TestType>::max();
+        tiled.addTile(tile, nextMinX, std::back_inserter(triangles));
+        maxActive = std::max(maxActive, tiled.activeVertexCount());
+    }
+    tiled.finish(std::back_inserter(triangles));
+    REQUIRE(tiled.activeVertexCount() == 0);
+    REQUIRE(maxActive < tileSize / 2);
+    // tiled output has no super-triangle: shift indices to compare
+    auto tt = TriangleVec{};
+    for(const auto& t : triangles)
+    {
+        const auto vv3 = VerticesArr3{t[0] + 3, t[1] + 3, t[2] + 3};
+        tt.push_back(Triangle{vv3, {noNeighbor, noNeighbor, noNeighbor}});
+    }
+    REQUIRE(sortedTriangles(tt) == sortedTriangles(expected.triangles));
+}
+
+TEMPLATE_LIST_TEST_CASE("Tiled triangulation of a grid", "", CoordTypes)
+{
+    // long strip: hull edges along its sides must not stay in the frontier
+    const int nCols = 200, nRows = 10, tileCols = 10;
+    auto vv = Vertices<TestType>{};
+    for(int i = 0; i < nCols; ++i)
+        for(int j = 0; j < nRows; ++j)
+            vv.push_back(V2d<TestType>::make(TestType(i), TestType(j)));
+    auto tiled = TiledTriangulation<TestType>(envelopBox(vv));
+    auto triangles = std::vector<VerticesArr3>{};
+    const std::size_t tileSize = tileCols * nRows;
+    std::size_t maxActive = 0;
+    for(std::size_t i = 0; i < vv.size(); i += tileSize)
+    {
+        const auto last = i + tileSize;
+        const auto tile = Vertices<TestType>(vv.begin() + i, vv.begin() + last);
+        const auto nextMinX = last < vv.size()
+                                  ? vv[last].x
+                                  : std::numeric_limits<TestType>::max();
+        tiled.addTile(tile, nextMinX, std::back_inserter(triangles));
+        maxActive = std::max(maxActive, tiled.activeVertexCount());
+    }
+    tiled.finish(std::back_inserter(triangles));
+    REQUIRE(maxActive < tileSize / 2);
+    // each grid cell is covered by two triangles exactly once
+    REQUIRE(triangles.size() == std::size_t(2 * (nCols - 1) * (nRows - 1)));
+    for(const auto& t : triangles)
+        REQUIRE(orient2D(vv[t[0]], vv[t[1]], vv[t[2]]) == TestType(1));
+    auto tt = TriangleVec{};
+    for(const auto& t : triangles)
+        tt.push_back(Triangle{t, {noNeighbor, noNeighbor, noNeighbor}});
+    const auto sorted = sortedTriangles(tt);
+    REQUIRE(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+}
+
+TEMPLATE_LIST_TEST_CASE("Locating points", "", CoordTypes)
+{
+    using V = V2d<TestType>;
+    // square with a square hole: triangulation is not convex
+    auto vv = Vertices<TestType>{
+        V::make(-100, -100),
+        V::make(100, -100),
+        V::make(100, 100),
+        V::make(-100, 100),
+        V::make(-30, -30),
+        V::make(30, -30),
+        V::make(30, 30),
+        V::make(-30, 30)};
+    std::mt19937 gen(23);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    while(vv.size() < 2000)
+    {
+        const auto x = TestType(dist(gen));
+        const auto y = TestType(dist(gen));
+        if(std::abs(x) > 31 || std::abs(y) > 31)
+            vv.push_back(V::make(x, y));
+    }
+    auto queries = Vertices<TestType>{};
+    std::uniform_real_distribution<double> queryDist(-120, 120);
+    for(int i = 0; i < 3000; ++i)
+    {
+        const auto x = TestType(queryDist(gen));
+        queries.push_back(V::make(x, TestType(queryDist(gen))));
+    }
+    queries.insert(queries.end(), vv.begin(), vv.begin() + 100);
+    const auto nThreads = GENERATE(as<std::size_t>{}, 1, 4);
+    const auto checkLocations = [&](const Triangulation<TestType>& cdt) {
+        const auto& pp = cdt.vertices;
+        const auto isInside = [&](const V& p) {
+            for(const auto& t : cdt.triangles)
+            {
+                const auto& tv = t.vertices;
+                if(locatePointTriangle(p, pp[tv[0]], pp[tv[1]], pp[tv[2]]) !=
+                   PtTriLocation::Outside)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        const auto check = [&](const V& p, const TriangleLocation& loc) {
+            if(!isInside(p))
+            {
+                REQUIRE(loc.triangle == noNeighbor);
+                REQUIRE(loc.location == PtTriLocation::Outside);
+                return;
+            }
+            REQUIRE(loc.triangle < cdt.triangles.size());
+            REQUIRE(loc.location != PtTriLocation::Outside);
+            const auto& tv = cdt.triangles[loc.triangle].vertices;
+            REQUIRE(
+                locatePointTriangle(p, pp[tv[0]], pp[tv[1]], pp[tv[2]]) ==
+                loc.location);
+        };
+        auto prev = TriangleLocation::make(noNeighbor, PtTriLocation::Outside);
+        for(const auto& p : queries)
+        {
+            const auto loc = cdt.locate(p);
+            check(p, loc);
+            check(p, cdt.locate(p, prev));
+            prev = loc;
+        }
+        const auto locations = cdt.locateMany(queries, nThreads);
+        REQUIRE(locations.size() == queries.size());
+        for(std::size_t i = 0; i < queries.size(); ++i)
+            check(queries[i], locations[i]);
+    };
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertRings({{0, 1, 2, 3}, {4, 5, 6, 7}});
+    checkLocations(cdt); // super-triangle
+    checkLocations(cdt.withSuperTriangleErased()); // convex
+    cdt.eraseOuterTrianglesAndHoles();
+    checkLocations(cdt);
+}
+
+TEMPLATE_LIST_TEST_CASE("Parallel mesh extraction", "", CoordTypes)
+{
+    using V = V2d<TestType>;
+    // square with a square hole
+    auto vv = Vertices<TestType>{
+        V::make(-100, -100),
+        V::make(100, -100),
+        V::make(100, 100),
+        V::make(-100, 100),
+        V::make(-30, -30),
+        V::make(30, -30),
+        V::make(30, 30),
+        V::make(-30, 30)};
+    std::mt19937 gen(29);
+    std::uniform_real_distribution<double> dist(-99, 99);
+    while(vv.size() < 10000)
+    {
+        const auto x = TestType(dist(gen));
+        const auto y = TestType(dist(gen));
+        if(std::abs(x) > 31 || std::abs(y) > 31)
+            vv.push_back(V::make(x, y));
+    }
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertRings({{0, 1, 2, 3}, {4, 5, 6, 7}});
+    cdt.eraseOuterTrianglesAndHoles();
+    const auto& tt = cdt.triangles;
+    const auto nThreads = GENERATE(as<std::size_t>{}, 1, 4);
+
+    const auto expectedEdges = extractEdgesFromTriangles(tt);
+    const auto edges = extractEdgesFromTrianglesParallel(tt, nThreads);
+    REQUIRE(edges.size() == expectedEdges.size());
+    REQUIRE(EdgeUSet(edges.begin(), edges.end()) == expectedEdges);
+
+    const auto loops = extractBoundaryLoopsParallel(tt, nThreads);
+    REQUIRE(loops.offsets.size() == 3);
+    REQUIRE(loops.items.size() == cdt.fixedEdges.size());
+    for(std::size_t iL = 0; iL < 2; ++iL)
+    {
+        const auto first = loops.offsets[iL];
+        const auto last = loops.offsets[iL + 1];
+        TestType area(0);
+        for(auto i = first; i < last; ++i)
+        {
+            const auto a = loops.items[i];
+            const auto b = loops.items[i + 1 < last ? i + 1 : first];
+            REQUIRE(cdt.fixedEdges.count(Edge(a, b)));
+            const auto &va = cdt.vertices[a], &vb = cdt.vertices[b];
+            area += va.x * vb.y - vb.x * va.y;
+        }
+        // outer loop is counter-clockwise, hole is clockwise
+        const auto loopEnd = loops.items.begin() + last;
+        const bool isOuter =
+            std::find(loops.items.begin() + first, loopEnd, 0) != loopEnd;
+        REQUIRE((area > 0) == isOuter);
+    }
+
+    const auto rings = extractVertexNeighborsParallel(
+        tt, VertInd(cdt.vertices.size()), nThreads);
+    REQUIRE(rings.offsets.size() == cdt.vertices.size() + 1);
+    REQUIRE(rings.items.size() == 2 * expectedEdges.size());
+    auto expectedRings = std::vector<std::vector<VertInd> >(vv.size());
+    for(const auto& e : expectedEdges)
+    {
+        expectedRings[e.v1()].push_back(e.v2());
+        expectedRings[e.v2()].push_back(e.v1());
+    }
+    for(std::size_t v = 0; v < vv.size(); ++v)
+    {
+        auto& expected = expectedRings[v];
+        std::sort(expected.begin(), expected.end());
+        const auto ring = std::vector<VertInd>(
+            rings.items.begin() + rings.offsets[v],
+            rings.items.begin() + rings.offsets[v + 1]);
+        REQUIRE(ring == expected);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Re-ordering for memory locality", "", CoordTypes)
+{
+    const auto strategy = GENERATE(
+        ReorderingStrategy::Hilbert, ReorderingStrategy::ReverseCuthillMcKee);
+    // average index distance between vertices of an edge
+    const auto meanEdgeSpan = [](const Triangulation<TestType>& t) {
+        double sum = 0;
+        const auto edges = extractEdgesFromTriangles(t.triangles);
+        for(const auto& e : edges)
+            sum += e.v2() - e.v1();
+        return sum / edges.size();
+    };
+    SECTION("Random points")
+    {
+        auto vv = Vertices<TestType>{};
+        std::mt19937 gen(31);
+        std::uniform_real_distribution<double> dist(-100, 100);
+        for(int i = 0; i < 5000; ++i)
+        {
+            const auto x = TestType(dist(gen));
+            vv.push_back(V2d<TestType>::make(x, TestType(dist(gen))));
+        }
+        auto cdt = Triangulation<TestType>();
+        cdt.insertVertices(vv);
+        REQUIRE_THROWS(cdt.reorder(strategy));
+        cdt.eraseSuperTriangle();
+        const auto spanBefore = meanEdgeSpan(cdt);
+        cdt.reorder(strategy);
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(meanEdgeSpan(cdt) < spanBefore / 10);
+    }
+    SECTION("Constraints and edge pieces are re-mapped")
+    {
+        const auto [vv, ee] = readInputFromFile<TestType>(
+            "inputs/issue-42-multiple-boundary-overlaps.txt");
+        auto cdt = Triangulation<TestType>();
+        cdt.insertVertices(vv);
+        cdt.conformToEdges(ee);
+        cdt.eraseOuterTrianglesAndHoles();
+        const auto original = cdt;
+        const Reordering r = cdt.reorder(strategy);
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(r.vertices.size() == cdt.vertices.size());
+        REQUIRE(r.triangles.size() == cdt.triangles.size());
+        auto newInds = std::vector<VertInd>(r.vertices.size());
+        for(std::size_t i = 0; i < r.vertices.size(); ++i)
+        {
+            REQUIRE(cdt.vertices[i] == original.vertices[r.vertices[i]]);
+            newInds[r.vertices[i]] = VertInd(i);
+        }
+        for(std::size_t i = 0; i < r.triangles.size(); ++i)
+        {
+            const auto& oldVV = original.triangles[r.triangles[i]].vertices;
+            for(int j = 0; j < 3; ++j)
+                REQUIRE(cdt.triangles[i].vertices[j] == newInds[oldVV[j]]);
+        }
+        const auto remap = [&](const Edge& e) {
+            return Edge(newInds[e.v1()], newInds[e.v2()]);
+        };
+        REQUIRE(cdt.fixedEdges.size() == original.fixedEdges.size());
+        for(const auto& e : original.fixedEdges)
+            REQUIRE(cdt.fixedEdges.count(remap(e)));
+        REQUIRE(!original.overlapCount.empty());
+        REQUIRE(cdt.overlapCount.size() == original.overlapCount.size());
+        for(const auto& oc : original.overlapCount)
+            REQUIRE(cdt.overlapCount.at(remap(oc.first)) == oc.second);
+        REQUIRE(!original.pieceToOriginals.empty());
+        REQUIRE(
+            cdt.pieceToOriginals.size() == original.pieceToOriginals.size());
+        for(const auto& pto : original.pieceToOriginals)
+        {
+            auto originals = EdgeVec{};
+            for(const auto& e : pto.second)
+                originals.push_back(remap(e));
+            REQUIRE(cdt.pieceToOriginals.at(remap(pto.first)) == originals);
+        }
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Regular grid locator", "", CoordTypes)
+{
+    auto gen = std::mt19937(42);
+    auto dist = std::uniform_real_distribution<double>(-10, 10);
+    auto vv = Vertices<TestType>{};
+    for(int i = 0; i < 2000; ++i)
+    {
+        const double x = dist(gen);
+        vv.push_back(V2d<TestType>::make(TestType(x), TestType(dist(gen))));
+    }
+    const auto ee = EdgeVec{Edge(121, 122), Edge(123, 124), Edge(125, 126)};
+
+    auto expected = Triangulation<TestType>(VertexInsertionOrder::AsProvided);
+    initializeWithRegularGrid(
+        TestType(-10), TestType(10), TestType(-10), TestType(10), 10, 10,
+        expected);
+    expected.insertVertices(vv);
+    expected.insertEdges(ee);
+
+    using Locator = LocatorRegularGrid<TestType>;
+    auto cdt = Triangulation<TestType, Locator>(
+        VertexInsertionOrder::AsProvided,
+        Locator(
+            TestType(-10), TestType(10), TestType(-10), TestType(10), 10, 10),
+        IntersectingConstraintEdges::Ignore,
+        TestType(0));
+    initializeWithRegularGrid(
+        TestType(-10), TestType(10), TestType(-10), TestType(10), 10, 10,
+        cdt);
+    cdt.insertVertices(vv);
+    cdt.insertEdges(ee);
+    REQUIRE(CDT::verifyTopology(cdt));
+    REQUIRE(cdt.vertices == expected.vertices);
+    REQUIRE(cdt.triangles.size() == expected.triangles.size());
+    REQUIRE(extractEdgesFromTriangles(cdt.triangles) ==
+            extractEdgesFromTriangles(expected.triangles));
+
+    SECTION("Copy with super-triangle erased is a no-op for custom geometry")
+    {
+        const auto copy = cdt.withSuperTriangleErased();
+        REQUIRE(!copy.isFinalized());
+        REQUIRE(copy.vertices == cdt.vertices);
+        REQUIRE(extractEdgesFromTriangles(copy.triangles) ==
+                extractEdgesFromTriangles(cdt.triangles));
+        REQUIRE(copy.fixedEdges == cdt.fixedEdges);
+    }
+
+    SECTION("Reset and re-use with the same grid")
+    {
+        cdt.reset();
+        REQUIRE(cdt.vertices.empty());
+        REQUIRE(cdt.triangles.empty());
+        REQUIRE(cdt.superGeometryVertexCount() == 0);
+        initializeWithRegularGrid(
+            TestType(-10), TestType(10), TestType(-10), TestType(10), 10, 10,
+            cdt);
+        cdt.insertVertices(vv);
+        cdt.insertEdges(ee);
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(cdt.vertices == expected.vertices);
+        REQUIRE(extractEdgesFromTriangles(cdt.triangles) ==
+                extractEdgesFromTriangles(expected.triangles));
+    }
+
+    SECTION("Requires triangulation initialized with the grid")
+    {
+        auto noGrid = Triangulation<TestType, Locator>(
+            VertexInsertionOrder::AsProvided,
+            Locator(
+                TestType(-10), TestType(10), TestType(-10), TestType(10), 10,
+                10),
+            IntersectingConstraintEdges::Ignore,
+            TestType(0));
+        REQUIRE_THROWS(noGrid.insertVertices(vv));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Alternative near-point locators", "", CoordTypes)
+{
+    auto gen = std::mt19937(9001);
+    auto dist = std::uniform_real_distribution<double>(-10, 10);
+    auto vv = Vertices<TestType>{};
+    for(int i = 0; i < 3000; ++i)
+    {
+        const double x = dist(gen);
+        vv.push_back(V2d<TestType>::make(TestType(x), TestType(dist(gen))));
+    }
+    const auto ee = EdgeVec{Edge(0, 1), Edge(2, 3), Edge(4, 5)};
+    const auto order = GENERATE(
+        VertexInsertionOrder::AsProvided,
+        VertexInsertionOrder::Randomized,
+        VertexInsertionOrder::BRIO);
+    // points are in general position: constrained Delaunay triangulation is
+    // unique and does not depend on insertion order, only triangles touching
+    // super-triangle do
+    const auto innerEdges = [](const TriangleVec& triangles) {
+        auto edges = extractEdgesFromTriangles(triangles);
+        for(auto it = edges.begin(); it != edges.end();)
+            it = it->v1() < 3 ? edges.erase(it) : std::next(it);
+        return edges;
+    };
+    auto expected = Triangulation<TestType>(VertexInsertionOrder::AsProvided);
+    expected.insertVertices(vv);
+    expected.insertEdges(ee);
+    const auto expectedEdges = innerEdges(expected.triangles);
+
+    SECTION("Bucket grid")
+    {
+        using Locator = LocatorBucketGrid<TestType>;
+        auto cdt = Triangulation<TestType, Locator>(order);
+        // two batches: grid is re-built and updated incrementally
+        cdt.insertVertices(Vertices<TestType>(vv.begin(), vv.begin() + 100));
+        cdt.insertVertices(Vertices<TestType>(vv.begin() + 100, vv.end()));
+        cdt.insertEdges(ee);
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(innerEdges(cdt.triangles) == expectedEdges);
+        cdt.removeVertex(VertInd(500));
+        cdt.removeVertex(VertInd(501));
+        cdt.insertVertices(Vertices<TestType>{vv[500], vv[501]});
+        REQUIRE(CDT::verifyTopology(cdt));
+    }
+    SECTION("Last inserted")
+    {
+        using Locator = LocatorLastInserted<TestType>;
+        auto cdt = Triangulation<TestType, Locator>(order);
+        cdt.insertVertices(Vertices<TestType>(vv.begin(), vv.begin() + 100));
+        cdt.insertVertices(Vertices<TestType>(vv.begin() + 100, vv.end()));
+        cdt.insertEdges(ee);
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(innerEdges(cdt.triangles) == expectedEdges);
+        // removing the last inserted vertex falls back to the first vertex
+        cdt.removeVertex(VertInd(vv.size() - 1));
+        cdt.insertVertices(Vertices<TestType>{vv.back()});
+        REQUIRE(CDT::verifyTopology(cdt));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Bucket grid finds nearest point", "", CoordTypes)
+{
+    auto gen = std::mt19937(42);
+    auto dist = std::uniform_real_distribution<double>(0, 1);
+    auto vv = Vertices<TestType>{};
+    auto locator = LocatorBucketGrid<TestType>();
+    locator.initialize(vv);
+    for(VertInd i = 0; i < 1000; ++i)
+    {
+        const double x = dist(gen);
+        vv.push_back(V2d<TestType>::make(TestType(x), TestType(dist(gen))));
+        locator.addPoint(i, vv);
+    }
+    for(VertInd i = 0; i < 1000; i += 3)
+        locator.removePoint(i, vv);
+    for(int i = 0; i < 1000; ++i)
+    {
+        const double x = dist(gen);
+        const auto pos = V2d<TestType>::make(TestType(x), TestType(dist(gen)));
+        auto minDistSq = std::numeric_limits<TestType>::max();
+        for(VertInd iV = 0; iV < 1000; ++iV)
+        {
+            if(iV % 3 != 0)
+                minDistSq = std::min(minDistSq, distanceSquared(pos, vv[iV]));
+        }
+        const VertInd iNear = locator.nearPoint(pos, vv);
+        REQUIRE(iNear % 3 != 0);
+        REQUIRE(distanceSquared(pos, vv[iNear]) == minDistSq);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE(
+    "Triangle depths with re-used workspace",
+    "",
+    CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    auto ee = EdgeVec{};
+    for(const TestType r : {TestType(5), TestType(3), TestType(1)})
+    {
+        const auto iFirst = VertInd(vv.size());
+        vv.push_back(V2d<TestType>::make(-r, -r));
+        vv.push_back(V2d<TestType>::make(r, -r));
+        vv.push_back(V2d<TestType>::make(r, r));
+        vv.push_back(V2d<TestType>::make(-r, r));
+        for(VertInd i = 0; i < 4; ++i)
+            ee.push_back(Edge(iFirst + i, iFirst + (i + 1) % 4));
+    }
+    // middle square's boundary overlaps itself
+    ee.insert(ee.end(), ee.begin() + 4, ee.begin() + 8);
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertEdges(ee);
+
+    const auto expected = cdt.calculateTriangleDepths();
+    auto depths = std::vector<LayerDepth>{};
+    auto workspace = TraversalWorkspace{};
+    for(int i = 0; i < 2; ++i)
+    {
+        cdt.calculateTriangleDepths(depths, workspace);
+        REQUIRE(depths == expected);
+    }
+    const auto depthAt = [&](const TestType x) {
+        const auto pos = V2d<TestType>::make(x, TestType(0.1));
+        return depths[cdt.locate(pos).triangle];
+    };
+    REQUIRE(depthAt(TestType(6)) == 0);
+    REQUIRE(depthAt(TestType(4)) == 1);
+    REQUIRE(depthAt(TestType(2)) == 3);
+    REQUIRE(depthAt(TestType(0)) == 4);
+}
+
+TEMPLATE_LIST_TEST_CASE("Parallel triangle depths", "", CoordTypes)
+{
+    const auto inputFile = GENERATE(
+        as<std::string>{},
+        "Capital A.txt",
+        "guitar no box.txt",
+        "issue-42-multiple-boundary-overlaps.txt",
+        "kidney.txt",
+        "overlapping constraints.txt");
+    const auto nThreads = GENERATE(as<std::size_t>{}, 1, 3, 8);
+    INFO("Input file is '" + inputFile + "'");
+    auto [vv, ee] = readInputFromFile<TestType>("inputs/" + inputFile);
+    RemoveDuplicatesAndRemapEdges(vv, ee);
+    auto cdt = Triangulation<TestType>();
+    cdt.insertVertices(vv);
+    cdt.insertEdges(ee);
+
+    REQUIRE(
+        cdt.calculateTriangleDepthsParallel(nThreads) ==
+        cdt.calculateTriangleDepths());
+    auto expected = cdt;
+    expected.eraseOuterTrianglesAndHoles();
+    cdt.eraseOuterTrianglesAndHolesParallel(nThreads);
+    REQUIRE(cdt.vertices == expected.vertices);
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+}
+
+TEMPLATE_LIST_TEST_CASE("Parallel vertex insertion", "", CoordTypes)
+{
+    const auto order = GENERATE(
+        VertexInsertionOrder::Randomized, VertexInsertionOrder::AsProvided);
+    const auto nThreads = GENERATE(as<std::size_t>{}, 1, 3, 8);
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    for(int i = 0; i < 20000; ++i)
+    {
+        const auto x = TestType(dist(gen));
+        vv.push_back(V2d<TestType>::make(x, TestType(dist(gen))));
+    }
+    auto serial = Triangulation<TestType>(order);
+    serial.insertVertices(vv);
+    auto cdt = Triangulation<TestType>(order);
+    cdt.insertVerticesParallel(vv, nThreads);
+    REQUIRE(CDT::verifyTopology(cdt));
+    REQUIRE(cdt.vertices == serial.vertices);
+    REQUIRE(
+        sortedTriangles(cdt.triangles) == sortedTriangles(serial.triangles));
+    SECTION("Constraints are inserted after merging")
+    {
+        const EdgeVec ee = {Edge(0, 1), Edge(2, 3), Edge(4, 5)};
+        cdt.insertEdges(ee);
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(cdt.fixedEdges.size() == ee.size());
+        cdt.eraseSuperTriangle();
+        REQUIRE(CDT::verifyTopology(cdt));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Parallel vertex insertion of a grid", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    for(int i = 0; i < 100; ++i)
+        for(int j = 0; j < 100; ++j)
+            vv.push_back(V2d<TestType>::make(TestType(i), TestType(j)));
+    auto cdt = Triangulation<TestType>(VertexInsertionOrder::Randomized);
+    cdt.insertVerticesParallel(vv, 4);
+    REQUIRE(CDT::verifyTopology(cdt));
+    REQUIRE(cdt.triangles.size() == 2 * cdt.vertices.size() - 5);
+    // no vertex is strictly inside circumcircle of a neighboring triangle
+    const auto& tt = cdt.triangles;
+    const auto& pp = cdt.vertices;
+    for(TriInd iT(0); iT < TriInd(tt.size()); ++iT)
+    {
+        const auto& t = tt[iT];
+        const auto& tv = t.vertices;
+        for(const TriInd iN : t.neighbors)
+        {
+            if(iN == noNeighbor)
+                continue;
+            const VertInd iOpo = opposedVertex(tt[iN], iT);
+            if(iOpo < 3 || *std::min_element(tv.begin(), tv.end()) < 3)
+                continue; // super-triangle vertex
+            REQUIRE_FALSE(isInCircumcircle(
+                pp[iOpo],
+                pp[tv[0]], pp[tv[1]], pp[tv[2]]));
+        }
+    }
+}
+
+TEST_CASE("Exceptions of worker threads reach the caller", "")
+{
+    SECTION("Task exception is re-thrown by join")
+    {
+        detail::ThreadGroup threads(2);
+        threads.run([] { throw std::runtime_error("worker"); });
+        threads.run([] {});
+        REQUIRE_THROWS_AS(threads.join(), std::runtime_error);
+        threads.run([] {});
+        REQUIRE_NOTHROW(threads.join());
+    }
+    SECTION("Threads are joined when calling thread throws")
+    {
+        const auto run = [] {
+            detail::ThreadGroup threads(1);
+            threads.run([] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            });
+            throw std::logic_error("caller");
+        };
+        REQUIRE_THROWS_AS(run(), std::logic_error);
+    }
+    SECTION("Parallel edge re-mapping")
+    {
+        const std::size_t n = 4 * detail::minParallelChunkSize;
+        auto ee = EdgeVec(n, Edge(0, 1));
+        const auto mapping = std::vector<std::size_t>{0, 1};
+        std::atomic<std::size_t> nCalls(0);
+        const auto makeEdge = [&](const VertInd v1, const VertInd v2) {
+            if(++nCalls == n)
+                throw std::runtime_error("last edge");
+            return Edge(v1, v2);
+        };
+        REQUIRE_THROWS_AS(
+            RemapEdgesParallel(
+                ee.begin(),
+                ee.end(),
+                mapping,
+                edge_get_v1,
+                edge_get_v2,
+                makeEdge,
+                4),
+            std::runtime_error);
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE(
+    "Independent triangulations in concurrent threads",
+    "",
+    CoordTypes)
+{
+    const auto order = GENERATE(
+        VertexInsertionOrder::Randomized, VertexInsertionOrder::BRIO);
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(-100, 100);
+    for(int i = 0; i < 5000; ++i)
+    {
+        const auto x = TestType(dist(gen));
+        vv.push_back(V2d<TestType>::make(x, TestType(dist(gen))));
+    }
+    auto expected = Triangulation<TestType>(order);
+    expected.insertVertices(vv);
+    // each thread triangulates the same points several times
+    auto results = std::vector<Triangulation<TestType> >(4);
+    auto threads = std::vector<std::thread>{};
+    for(auto& cdt : results)
+    {
+        threads.emplace_back([&vv, &cdt, order]() {
+            for(int i = 0; i < 3; ++i)
+            {
+                cdt = Triangulation<TestType>(order);
+                cdt.insertVertices(vv);
+            }
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+    for(const auto& cdt : results)
+    {
+        REQUIRE(cdt.vertices == expected.vertices);
+        REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+        REQUIRE(
+            sortedTriangles(cdt.triangles) ==
+            sortedTriangles(expected.triangles));
+    }
+}
+
+TEMPLATE_LIST_TEST_CASE("Re-using triangulation after reset", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    for(int i = 0; i < 500; ++i)
+    {
+        const double x = dist(gen);
+        vv.push_back(V2d<TestType>::make(TestType(x), TestType(dist(gen))));
+    }
+    const auto ee = EdgeVec{Edge(0, 1), Edge(2, 3), Edge(3, 4), Edge(5, 6)};
+    auto triangulate = [&](Triangulation<TestType>& cdt) {
+        cdt.insertVertices(vv);
+        cdt.insertEdges(ee);
+        cdt.eraseOuterTrianglesAndHoles();
+    };
+    auto expected = Triangulation<TestType>(VertexInsertionOrder::AsProvided);
+    triangulate(expected);
+
+    auto cdt = Triangulation<TestType>(VertexInsertionOrder::AsProvided);
+    // first use: different input including custom super-geometry
+    initializeWithRegularGrid(
+        TestType(-20), TestType(20), TestType(-20), TestType(20), 5, 5, cdt);
+    cdt.insertVertices(Vertices<TestType>(vv.begin(), vv.begin() + 100));
+    cdt.insertEdges(EdgeVec{Edge(36, 37)});
+    cdt.reset();
+    REQUIRE(cdt.vertices.empty());
+    REQUIRE(cdt.triangles.empty());
+    REQUIRE(cdt.fixedEdges.empty());
+    REQUIRE(cdt.vertTris.empty());
+    REQUIRE_FALSE(cdt.isFinalized());
+    for(int i = 0; i < 3; ++i)
+    {
+        triangulate(cdt);
+        const auto capacity = cdt.triangles.capacity();
+        REQUIRE(CDT::verifyTopology(cdt));
+        REQUIRE(cdt.vertices == expected.vertices);
+        REQUIRE(cdt.fixedEdges == expected.fixedEdges);
+        REQUIRE(cdt.triangles.size() == expected.triangles.size());
+        for(std::size_t iT = 0; iT < cdt.triangles.size(); ++iT)
+        {
+            const auto& t = cdt.triangles[iT];
+            REQUIRE(t.vertices == expected.triangles[iT].vertices);
+            REQUIRE(t.neighbors == expected.triangles[iT].neighbors);
+        }
+        cdt.reset();
+        REQUIRE(cdt.triangles.capacity() == capacity);
+    }
+}
+
+namespace
+{
+
+std::size_t nCountedAllocations = 0;
+
+/// Stateless allocator that counts allocations
+template <typename U>
+struct CountingAllocator
+{
+    typedef U value_type;
+    CountingAllocator() = default;
+    template <typename V>
+    CountingAllocator(const CountingAllocator<V>&)
+    {}
+    U* allocate(const std::size_t n)
+    {
+        ++nCountedAllocations;
+        return std::allocator<U>().allocate(n);
+    }
+    void deallocate(U* const p, const std::size_t n)
+    {
+        std::allocator<U>().deallocate(p, n);
+    }
+};
+
+template <typename U, typename V>
+bool operator==(const CountingAllocator<U>&, const CountingAllocator<V>&)
+{
+    return true;
+}
+
+template <typename U, typename V>
+bool operator!=(const CountingAllocator<U>&, const CountingAllocator<V>&)
+{
+    return false;
+}
+
+} // namespace
+
+TEMPLATE_LIST_TEST_CASE("Custom allocator", "", CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> dist(-10, 10);
+    for(int i = 0; i < 500; ++i)
+    {
+        const double x = dist(gen);
+        vv.push_back(V2d<TestType>::make(TestType(x), TestType(dist(gen))));
+    }
+    const auto ee = EdgeVec{Edge(0, 1), Edge(2, 3), Edge(3, 4), Edge(5, 6)};
+    auto expected = Triangulation<TestType>(VertexInsertionOrder::AsProvided);
+    expected.insertVertices(vv);
+    expected.conformToEdges(ee);
+
+    using Allocator = CountingAllocator<TestType>;
+    auto cdt = Triangulation<TestType, LocatorKDTree<TestType>, Allocator>(
+        VertexInsertionOrder::AsProvided);
+    nCountedAllocations = 0;
+    cdt.insertVertices(vv);
+    cdt.conformToEdges(ee);
+    REQUIRE(nCountedAllocations > 0);
+    REQUIRE(CDT::verifyTopology(cdt));
+    REQUIRE(std::equal(
+        cdt.vertices.begin(), cdt.vertices.end(), expected.vertices.begin()));
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+    REQUIRE(
+        EdgeUSet(cdt.fixedEdges.begin(), cdt.fixedEdges.end()) ==
+        expected.fixedEdges);
+    REQUIRE(cdt.pieceToOriginals.size() == expected.pieceToOriginals.size());
+
+    // binary format does not depend on allocator
+    std::stringstream ss;
+    writeBinary(ss, cdt);
+    auto loaded = Triangulation<TestType>();
+    readBinary(ss, loaded);
+    REQUIRE(extractAllEdges(loaded) == extractAllEdges(expected));
+
+    cdt.eraseOuterTrianglesAndHoles();
+    expected.eraseOuterTrianglesAndHoles();
+    REQUIRE(extractAllEdges(cdt) == extractAllEdges(expected));
+}
+
+TEMPLATE_LIST_TEST_CASE(
+    "Removing triangles by indices and bitmask",
+    "",
+    CoordTypes)
+{
+    auto vv = Vertices<TestType>{};
+    for(int i = 0; i < 10; ++i)
+    {
+        for(int j = 0; j < 10; ++j)
+        {
+            const auto x = TestType(i + (j % 3) * 0.1);
+            vv.push_back(V2d<TestType>::make(x, TestType(j)));
+        }
+    }
+    auto cdtSet = Triangulation<TestType>(VertexInsertionOrder::AsProvided);
+    cdtSet.insertVertices(vv);
+    auto cdtMask = cdtSet;
+    TriIndUSet removed;
+    std::vector<bool> isRemoved(cdtSet.triangles.size(), false);
+    for(TriInd iT = 0; iT < cdtSet.triangles.size(); iT += 3)
+    {
+        removed.insert(iT);
+        isRemoved[iT] = true;
+    }
+    cdtSet.removeTriangles(removed);
+    cdtMask.removeTriangles(isRemoved);
+    REQUIRE(cdtSet.triangles.size() == isRemoved.size() - removed.size());
+    REQUIRE(cdtMask.triangles.size() == cdtSet.triangles.size());
+    REQUIRE(cdtMask.vertTris.empty());
+    for(TriInd iT = 0; iT < cdtMask.triangles.size(); ++iT)
+    {
+        const auto& t = cdtMask.triangles[iT];
+        REQUIRE(t.vertices == cdtSet.triangles[iT].vertices);
+        REQUIRE(t.neighbors == cdtSet.triangles[iT].neighbors);
+        for(const auto iN : t.neighbors)
+        {
+            if(iN == noNeighbor)
+                continue;
+            REQUIRE(iN < cdtMask.triangles.size());
+            const auto& nn = cdtMask.triangles[iN].neighbors;
+            REQUIRE(std::find(nn.begin(), nn.end(), iT) != nn.end());
+        }
+    }
+}
+
+#ifdef CDT_ENABLE_STATS
+TEST_CASE("Hot-path stats are collected", "")
+{
+    auto vv = Vertices<double>{};
+    for(int i = 0; i < 30; ++i)
+        for(int j = 0; j < 30; ++j)
+            vv.push_back(V2d<double>::make(i, j));
+    auto cdt = Triangulation<double>();
+    cdt.insertVertices(vv);
+    REQUIRE(cdt.stats.walkSteps > 0);
+    REQUIRE(cdt.stats.kdTreeNodesVisited > 0);
+    REQUIRE(cdt.stats.flips > 0);
+    REQUIRE(cdt.stats.predicateSlowPaths > 0); // grid: many co-circular
+    REQUIRE(cdt.stats.pseudopolygons == 0);
+    REQUIRE(cdt.stats.conformingSplits == 0);
+    cdt.insertEdges(EdgeVec(1, Edge(0, 898))); // no vertices on the edge
+    REQUIRE(cdt.stats.pseudopolygons == 2);
+    REQUIRE(cdt.stats.pseudopolygonMaxDepth > 0);
+    const std::size_t slowPaths = cdt.stats.predicateSlowPaths;
+    // predicates outside of triangulation's methods are not counted
+    isInCircumcircle(vv[0], vv[1], vv[31], vv[30]);
+    REQUIRE(cdt.stats.predicateSlowPaths == slowPaths);
+
+    auto conforming = Triangulation<double>();
+    conforming.insertVertices(vv);
+    conforming.conformToEdges(EdgeVec(1, Edge(0, 898)));
+    REQUIRE(conforming.stats.conformingSplits > 0);
+    REQUIRE(CDT::verifyTopology(conforming));
+}
+#endif